@@ -44,54 +44,7 @@
 
 #include "ape.h"
 
-#include <APE_SHM.h>
-
-void __attribute__((noreturn)) loaderLoop(void)
-{
-    // Update SHM.Sig to signal ready.
-    SHM.SegSig.bits.Sig = SHM_SEG_SIG_SIG_LOADER;
-    SHM.FwStatus.bits.Ready = 1;
-
-    for(;;)
-    {
-        uint32_t command = SHM.LoaderCommand.bits.Command;
-        if(!command) continue;
-
-        uint32_t arg0 = SHM.LoaderArg0.r32;
-        uint32_t arg1 = SHM.LoaderArg1.r32;
-
-        switch(command)
-        {
-            default:
-                break;
-
-            case SHM_LOADER_COMMAND_COMMAND_READ_MEM:
-            {
-                // Read word address specified in arg0
-                uint32_t* addr = ((void*)arg0);
-                SHM.LoaderArg0.r32 = *addr;
-                break;
-            }
-            case SHM_LOADER_COMMAND_COMMAND_WRITE_MEM:
-            {
-                // Write word address specified in arg0 with arg1
-                uint32_t* addr = ((void*)arg0);
-                *addr = arg1;
-                break;
-            }
-            case SHM_LOADER_COMMAND_COMMAND_CALL:
-            {
-                // call address specified in arg0.
-                void (*function)(uint32_t) = ((void*)arg0);
-                function(arg1);
-                break;
-            }
-        }
-
-        // Mark command as handled.
-        SHM.LoaderCommand.bits.Command = 0;
-    }
-}
+#include <Loader.h>
 
 void __attribute__((noreturn)) __start()
 {
@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       ape_loader_ring.h
+///
+/// @project    
+///
+/// @brief      Command ring shared between the host and the APE loader
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef APE_LOADER_RING_H
+#define APE_LOADER_RING_H
+
+#include <stdint.h>
+
+/*
+ * In addition to the single LoaderCommand mailbox, the loader drains a ring
+ * of commands placed in SHM. The ring location is advertised through
+ * SHM.SegMessageBufferOffset / SHM.SegMessageBufferLength once the loader is
+ * ready. The host fills entries and advances producer, the loader handles
+ * every entry up to producer and then advances consumer once per batch.
+ */
+#define APE_LOADER_RING_OFFSET      (0x2000u)   /*< Offset of the ring in SHM, clear of the loader image at 0xB00 (checked by apeloader/ape.ld). */
+#define APE_LOADER_RING_ENTRIES     (127u)
+
+typedef struct {
+    uint32_t    command;    /*< One of SHM_LOADER_COMMAND_COMMAND_* */
+    uint32_t    arg0;
+    uint32_t    arg1;
+    uint32_t    result;     /*< READ_MEM value, DECOMPRESS length or CRC result. */
+} APELoaderRingEntry_t;
+
+typedef struct {
+    uint32_t    producer;   /*< Next entry to be filled, written by the host. */
+    uint32_t    consumer;   /*< Next entry to be handled, written by the loader. */
+    uint32_t    entries;    /*< Number of entries in the ring. */
+    uint32_t    reserved;
+    APELoaderRingEntry_t entry[APE_LOADER_RING_ENTRIES];
+} APELoaderRing_t;
+
+#endif /* APE_LOADER_RING_H */
@@ -474,6 +474,11 @@ typedef register_container RegSHM4028_t {
 #define     SHM_LOADER_COMMAND_COMMAND_READ_MEM 0x1u
 #define     SHM_LOADER_COMMAND_COMMAND_WRITE_MEM 0x2u
 #define     SHM_LOADER_COMMAND_COMMAND_CALL 0x3u
+#define     SHM_LOADER_COMMAND_COMMAND_READ_BLOCK 0x4u
+#define     SHM_LOADER_COMMAND_COMMAND_WRITE_BLOCK 0x5u
+#define     SHM_LOADER_COMMAND_COMMAND_MEMSET 0x6u
+#define     SHM_LOADER_COMMAND_COMMAND_DECOMPRESS 0x7u
+#define     SHM_LOADER_COMMAND_COMMAND_CRC 0x8u
 
 
 /** @brief Register definition for @ref SHM_t.LoaderCommand. */
@@ -941,6 +946,56 @@ typedef register_container RegSHMRcpuCpmuStatus_t {
 #endif /* CXX_SIMULATOR */
 } RegSHMRcpuCpmuStatus_t;
 
+#define REG_SHM_RCPU_BOOT_TIMELINE_COUNT ((volatile BCM5719_SHM_H_uint32_t*)0xc001413c) /* Number of entries written to RcpuBootTimeline by stage1. */
+/** @brief Register definition for @ref SHM_t.RcpuBootTimelineCount. */
+typedef register_container RegSHMRcpuBootTimelineCount_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "RcpuBootTimelineCount"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMRcpuBootTimelineCount_t()
+    {
+        /** @brief constructor for @ref SHM_t.RcpuBootTimelineCount. */
+        r32.setName("RcpuBootTimelineCount");
+    }
+    RegSHMRcpuBootTimelineCount_t& operator=(const RegSHMRcpuBootTimelineCount_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMRcpuBootTimelineCount_t;
+
+#define REG_SHM_RCPU_BOOT_TIMELINE ((volatile BCM5719_SHM_H_uint32_t*)0xc0014140) /* Ring of (status, DEVICE.Timer) pairs logged by stage1 at each reportStatus call, indexed by RcpuBootTimelineCount. */
+/** @brief Register definition for @ref SHM_t.RcpuBootTimeline. */
+typedef register_container RegSHMRcpuBootTimeline_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "RcpuBootTimeline"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMRcpuBootTimeline_t()
+    {
+        /** @brief constructor for @ref SHM_t.RcpuBootTimeline. */
+        r32.setName("RcpuBootTimeline");
+    }
+    RegSHMRcpuBootTimeline_t& operator=(const RegSHMRcpuBootTimeline_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMRcpuBootTimeline_t;
+
 #define REG_SHM_HOST_SEG_SIG ((volatile BCM5719_SHM_H_uint32_t*)0xc0014200) /* Set to APE_HOST_MAGIC ('HOST') to indicate the section is valid. */
 /** @brief Register definition for @ref SHM_t.HostSegSig. */
 typedef register_container RegSHMHostSegSig_t {
@@ -1359,6 +1414,31 @@ typedef register_container RegSHMProtMac0Low_t {
 #endif /* CXX_SIMULATOR */
 } RegSHMProtMac0Low_t;
 
+#define REG_SHM_LOADER_BUFFER ((volatile BCM5719_SHM_H_uint32_t*)0xc0014400) /* Staging area for the APE loader READ_BLOCK, WRITE_BLOCK, MEMSET and DECOMPRESS commands. MEMSET uses the first word as the fill value. */
+/** @brief Register definition for @ref SHM_t.LoaderBuffer. */
+typedef register_container RegSHMLoaderBuffer_t {
+    /** @brief 32bit direct register access. */
+    BCM5719_SHM_H_uint32_t r32;
+#ifdef CXX_SIMULATOR
+    /** @brief Register name for use with the simulator. */
+    const char* getName(void) { return "LoaderBuffer"; }
+
+    /** @brief Print register value. */
+    void print(void) { r32.print(); }
+
+    RegSHMLoaderBuffer_t()
+    {
+        /** @brief constructor for @ref SHM_t.LoaderBuffer. */
+        r32.setName("LoaderBuffer");
+    }
+    RegSHMLoaderBuffer_t& operator=(const RegSHMLoaderBuffer_t& other)
+    {
+        r32 = other.r32;
+        return *this;
+    }
+#endif /* CXX_SIMULATOR */
+} RegSHMLoaderBuffer_t;
+
 #define REG_SHM_NCSI_SIG ((volatile BCM5719_SHM_H_uint32_t*)0xc0014800) /* Set to NCSI_MAGIC ('NCSI') by APE firmware. NOTE: all words in the NCSI section are available in the function 0 SHM area only. */
 /** @brief Register definition for @ref SHM_t.NcsiSig. */
 typedef register_container RegSHMNcsiSig_t {
@@ -1649,7 +1729,13 @@ typedef struct SHM_t {
     RegSHMRcpuCpmuStatus_t RcpuCpmuStatus;
 
     /** @brief Reserved bytes to pad out data structure. */
-    BCM5719_SHM_H_uint32_t reserved_308[51];
+    BCM5719_SHM_H_uint32_t reserved_308[2];
+
+    /** @brief Number of entries written to RcpuBootTimeline by stage1. */
+    RegSHMRcpuBootTimelineCount_t RcpuBootTimelineCount;
+
+    /** @brief Ring of (status, DEVICE.Timer) pairs logged by stage1 at each reportStatus call, indexed by RcpuBootTimelineCount. */
+    RegSHMRcpuBootTimeline_t RcpuBootTimeline[48];
 
     /** @brief Set to APE_HOST_MAGIC ('HOST') to indicate the section is valid. */
     RegSHMHostSegSig_t HostSegSig;
@@ -1703,7 +1789,10 @@ typedef struct SHM_t {
     RegSHMProtMac0Low_t ProtMac0Low;
 
     /** @brief Reserved bytes to pad out data structure. */
-    BCM5719_SHM_H_uint32_t reserved_796[313];
+    BCM5719_SHM_H_uint32_t reserved_796[57];
+
+    /** @brief Staging area for the APE loader READ_BLOCK, WRITE_BLOCK, MEMSET and DECOMPRESS commands. MEMSET uses the first word as the fill value. */
+    RegSHMLoaderBuffer_t LoaderBuffer[256];
 
     /** @brief Set to NCSI_MAGIC ('NCSI') by APE firmware. NOTE: all words in the NCSI section are available in the function 0 SHM area only. */
     RegSHMNcsiSig_t NcsiSig;
@@ -1764,6 +1853,11 @@ typedef struct SHM_t {
         RcpuCfgHw.r32.setComponentOffset(0x128);
         RcpuCfgHw2.r32.setComponentOffset(0x12c);
         RcpuCpmuStatus.r32.setComponentOffset(0x130);
+        RcpuBootTimelineCount.r32.setComponentOffset(0x13c);
+        for(int i = 0; i < 48; i++)
+        {
+            RcpuBootTimeline[i].r32.setComponentOffset(0x140 + (i * 4));
+        }
         HostSegSig.r32.setComponentOffset(0x200);
         HostSegLen.r32.setComponentOffset(0x204);
         HostInitCount.r32.setComponentOffset(0x208);
@@ -1777,6 +1871,10 @@ typedef struct SHM_t {
         ProtMagic.r32.setComponentOffset(0x308);
         ProtMac0High.r32.setComponentOffset(0x314);
         ProtMac0Low.r32.setComponentOffset(0x318);
+        for(int i = 0; i < 256; i++)
+        {
+            LoaderBuffer[i].r32.setComponentOffset(0x400 + (i * 4));
+        }
         NcsiSig.r32.setComponentOffset(0x800);
         NcsiBuildTime.r32.setComponentOffset(0x810);
         NcsiBuildTime2.r32.setComponentOffset(0x814);
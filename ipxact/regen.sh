@@ -3,6 +3,56 @@ set -e
 IPXACT=~/git/ipxact/build/ipxact
 PROJECT=bcm5719
 
+# The ipxact templates bind every register with a read_from_ram/write_to_ram
+# callback pair. 32 bit registers backed only by BAR memory are bound directly
+# with setMMIOBase instead, see CXXRegister::setMMIOBase.
+bind_mmio()
+{
+    perl -0pi -e 's/^([ \t]*)(\S+\.r32)\.installReadCallback\(read_from_ram, (\(uint8_t \*\)base)\);\n[ \t]*\2\.installWriteCallback\(write_to_ram, \3\);/$1$2.setMMIOBase($3);/mg' "$@"
+}
+
+# The ape_cpp template gives each APE block its own per-word loader mailbox
+# helpers. Use the shared APELoader callbacks instead, they keep mailbox
+# commands ordered with the loader command ring.
+use_ape_loader()
+{
+    perl -0pi -e 's/static uint32_t loader_read_mem\(.*?\n}\n\nstatic uint32_t loader_write_mem\(.*?\n}\n\n//s;
+                  s/#include <bcm5719_SHM.h>\n/#include <APELoader.h>\n/;
+                  s/loader_read_mem/APELoader_readCallback/g;
+                  s/loader_write_mem/APELoader_writeCallback/g' "$@"
+}
+
+# The templates leave every simulator register CACHE_VOLATILE. Registers
+# explicitly marked non-volatile in the given XML keep a cached value:
+# read-only ones use CACHE_READ_ONCE, the others CACHE_WRITE_THROUGH. The
+# policy is set right after the register is bound.
+cache_policies()
+{
+    perl -0 -e '
+        my $xml = do { local $/; open(my $f, "<", shift @ARGV) or die; <$f> };
+        my %policy;
+        while ($xml =~ m{<ipxact:register>(.*?)</ipxact:register>}sg)
+        {
+            (my $reg = $1) =~ s{<ipxact:field>.*?</ipxact:field>}{}sg;
+            next unless $reg =~ m{<ipxact:volatile>false</ipxact:volatile>};
+            my ($name) = $reg =~ m{<ipxact:name>(.*?)</ipxact:name>};
+            $name = join("", map { ucfirst lc } split(/[_ ]+/, $name));
+            $policy{$name} = ($reg =~ m{<ipxact:access>read-only</ipxact:access>}) ?
+                "CACHE_READ_ONCE" : "CACHE_WRITE_THROUGH";
+        }
+        for my $file (@ARGV)
+        {
+            my $cpp = do { local $/; open(my $f, "<", $file) or die; <$f> };
+            for my $name (sort keys %policy)
+            {
+                $cpp =~ s{^([ \t]*)(\w+)\.$name\.r32\.(?:setMMIOBase|installWriteCallback)\(.*?\);\n}
+                         {$&$1$2.$name.r32.setCachePolicy(CXXRegisterBase::$policy{$name});\n}m;
+            }
+            open(my $f, ">", $file) or die;
+            print $f $cpp;
+        }' "$@"
+}
+
 echo "Regenerating Bcm5719 header"
 
 ${IPXACT} -p ${PROJECT} APE_component.xml SHM.xml DEVICE.xml NVM.xml bcm5719.xml bcm5719_full.xml
@@ -24,6 +74,9 @@ mv bcm5719_BOOTCODE.h ../include
 
 
 ${IPXACT} -p ${PROJECT} bcm5719_full.xml bcm5719.cpp
+bind_mmio *_sim.cpp
+cache_policies DEVICE.xml bcm5719_DEVICE_sim.cpp
+cache_policies SHM.xml bcm5719_SHM_sim.cpp
 mv *.cpp ../simulator/
 
 # ${IPXACT} -p ${PROJECT} bcm5719_full.xml bcm5719.s
@@ -57,4 +110,5 @@ rm APE_SHM*.cpp
 rm APE_NVM*.cpp
 rm APE_DEVICE*.cpp
 rm APE_TX_PORT*.cpp
+use_ape_loader *_sim.cpp
 mv *.cpp ../simulator/
@@ -44,73 +44,16 @@
 #include "bcm5719_APE_PERI.h"
 #include "bcm5719_DEVICE.h"
 
-void APE_aquireLock(void)
-{
-    RegAPE_PERIPerLockRequestPhy0_t lock_req;
-    lock_req.r32 = 0;
-    lock_req.bits.Bootcode = 1;
-
-    uint8_t function = DEVICE.Status.bits.FunctionNumber;
-    switch(function)
-    {
-        default:
-        case 0:
-            APE_PERI.PerLockRequestPhy0.r32 = lock_req.r32;
-            do
-            {
-                // spin
-            } while(lock_req.r32 != APE_PERI.PerLockGrantPhy0.r32);
-            return;
-
-        case 1:
-            APE_PERI.PerLockRequestPhy1.r32 = lock_req.r32;
-            do
-            {
-                // spin
-            } while(lock_req.r32 != APE_PERI.PerLockGrantPhy1.r32);
-            return;
-
-        case 2:
-            APE_PERI.PerLockRequestPhy2.r32 = lock_req.r32;
-            do
-            {
-                // spin
-            } while(lock_req.r32 != APE_PERI.PerLockGrantPhy2.r32);
-            return;
-
-        case 3:
-            APE_PERI.PerLockRequestPhy3.r32 = lock_req.r32;
-            do
-            {
-                // spin
-            } while(lock_req.r32 != APE_PERI.PerLockGrantPhy3.r32);
-            return;
-    }
+#include <Lock.h>
 
+bool APE_aquireLock(void)
+{
+    return Lock_acquire(LOCK_APE, LOCK_TIMEOUT_SPINS);
 }
 
 void APE_releaseLock(void)
 {
-    RegAPE_PERIPerLockGrantPhy0_t lock_release;
-    lock_release.r32 = 0;
-    lock_release.bits.Bootcode = 1;
-
-    uint8_t function = DEVICE.Status.bits.FunctionNumber;
-    switch(function)
-    {
-        default:
-        case 0:
-            APE_PERI.PerLockGrantPhy0.r32 = lock_release.r32;
-
-        case 1:
-            APE_PERI.PerLockGrantPhy1.r32 = lock_release.r32;
-
-        case 2:
-            APE_PERI.PerLockGrantPhy2.r32 = lock_release.r32;
-
-        case 3:
-            APE_PERI.PerLockGrantPhy3.r32 = lock_release.r32;
-    }
+    Lock_release(LOCK_APE);
 }
 
 void APE_releaseAllLocks(void)
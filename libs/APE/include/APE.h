@@ -45,7 +45,9 @@
 #ifndef APE_H
 #define APE_H
 
-void APE_aquireLock(void);
+#include <stdbool.h>
+
+bool APE_aquireLock(void);
 
 void APE_releaseLock(void);
 
@@ -45,6 +45,9 @@
 #include <Compress.h>
 
 #include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 
 // Original implementation from https://github.com/hlandau/ortega/blob/master/apestamp.c
 
@@ -292,6 +295,10 @@ int32_t compress(uint8_t *outBuffer, int32_t outBytes,
         if (!mask)
         {
             // Send at most eight units of code together.
+            if (codeBufPtr > outBytes)
+            {
+                return -1;
+            }
             for (i=0; i<codeBufPtr; ++i)
             {
                 *outBuffer++ = codeBuf[i];
@@ -338,6 +345,10 @@ int32_t compress(uint8_t *outBuffer, int32_t outBytes,
     // Send remaining code.
     if (codeBufPtr > 1)
     {
+        if (codeBufPtr > outBytes)
+        {
+            return -1;
+        }
         for (i=0; i<codeBufPtr; ++i)
         {
             *outBuffer++ = codeBuf[i];
@@ -350,4 +361,351 @@ int32_t compress(uint8_t *outBuffer, int32_t outBytes,
     // *bytesWritten = bytesWritten_;
 
     return bytesWritten_;
-}
\ No newline at end of file
+}
+
+// Collects up to eight literal/reference units behind their control byte.
+typedef struct {
+    uint8_t *outBuffer;
+    int32_t outBytes;
+    int32_t written;
+
+    uint8_t codeBuf[17];
+    int codeBufPtr;
+    uint8_t mask;
+} code_writer;
+
+static void writer_init(code_writer *w, uint8_t *outBuffer, int32_t outBytes)
+{
+    w->outBuffer = outBuffer;
+    w->outBytes = outBytes;
+    w->written = 0;
+    w->codeBuf[0] = 0;
+    w->codeBufPtr = 1;
+    w->mask = 1;
+}
+
+static bool writer_flush(code_writer *w)
+{
+    if (w->codeBufPtr > 1)
+    {
+        if (w->written + w->codeBufPtr > w->outBytes)
+        {
+            return false;
+        }
+
+        memcpy(&w->outBuffer[w->written], w->codeBuf, w->codeBufPtr);
+        w->written += w->codeBufPtr;
+    }
+
+    w->codeBuf[0] = 0;
+    w->codeBufPtr = 1;
+    w->mask = 1;
+    return true;
+}
+
+static bool writer_next(code_writer *w)
+{
+    w->mask <<= 1;
+    return w->mask ? true : writer_flush(w);
+}
+
+static bool writer_literal(code_writer *w, uint8_t c)
+{
+    w->codeBuf[0] |= w->mask;
+    w->codeBuf[w->codeBufPtr++] = c;
+    return writer_next(w);
+}
+
+static bool writer_reference(code_writer *w, int pos, int len)
+{
+    assert(len > THRESHOLD && len <= F);
+    w->codeBuf[w->codeBufPtr++] = (uint8_t)pos;
+    w->codeBuf[w->codeBufPtr++] = (uint8_t)(((pos >> 3) & 0xE0) | (len - (THRESHOLD+1)));
+    return writer_next(w);
+}
+
+// Returns the number of equal leading bytes of a and b, up to maxLen.
+static inline int match_length(const uint8_t *a, const uint8_t *b, int maxLen)
+{
+    int len = 0;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    // Compare a word at a time, the first differing byte is the lowest set one.
+    while (len + 8 <= maxLen)
+    {
+        uint64_t x, y;
+        memcpy(&x, &a[len], sizeof(x));
+        memcpy(&y, &b[len], sizeof(y));
+        if (x != y)
+        {
+            return len + (__builtin_ctzll(x ^ y) >> 3);
+        }
+        len += 8;
+    }
+#endif
+
+    while (len < maxLen && a[len] == b[len])
+    {
+        len++;
+    }
+
+    return len;
+}
+
+// The hash chain finder works on a flat copy of the stream: N-F spaces,
+// matching the decoder's initial dictionary, followed by the input. Position
+// k of this buffer lives at k % N in the decoder's ring, so matches no
+// further than N-F back can be emitted as-is. This is the same window the
+// tree finder uses.
+#define HASH_BITS 12
+#define HASH_SIZE (1 << HASH_BITS)
+#define WINDOW (N-F)
+
+typedef struct {
+    const uint8_t *buf;
+    int32_t end;
+
+    int32_t head[HASH_SIZE];
+    int32_t prev[N];
+} hash_chain_state;
+
+static inline uint32_t hc_hash(const uint8_t *p)
+{
+    uint32_t key = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+    return (key * 2654435761u) >> (32 - HASH_BITS);
+}
+
+static inline void hc_insert(hash_chain_state *st, int32_t k)
+{
+    if (k + THRESHOLD < st->end)
+    {
+        uint32_t h = hc_hash(&st->buf[k]);
+        st->prev[k & (N-1)] = st->head[h];
+        st->head[h] = k;
+    }
+}
+
+// Finds the longest match for buf[k..] among the earlier positions with the
+// same hash, visiting at most depth candidates.
+static int hc_find(const hash_chain_state *st, int32_t k, int maxLen,
+                   uint32_t depth, int niceLen, int32_t *matchPos)
+{
+    const uint8_t *key = &st->buf[k];
+    int best = THRESHOLD;
+
+    if (k + THRESHOLD >= st->end)
+    {
+        return 0;
+    }
+
+    int32_t cand = st->head[hc_hash(key)];
+    while (cand >= 0 && k - cand <= WINDOW && best < maxLen && depth--)
+    {
+        const uint8_t *p = &st->buf[cand];
+        // Only a candidate that beats the best so far is worth comparing.
+        if (p[best] == key[best] && p[0] == key[0])
+        {
+            int len = match_length(p, key, maxLen);
+            if (len > best)
+            {
+                best = len;
+                *matchPos = cand;
+                if (len >= niceLen)
+                {
+                    break;
+                }
+            }
+        }
+
+        int32_t next = st->prev[cand & (N-1)];
+        if (next >= cand)
+        {
+            // The ring entry was reused by a newer position.
+            break;
+        }
+        cand = next;
+    }
+
+    return best > THRESHOLD ? best : 0;
+}
+
+static hash_chain_state *hc_init(const uint8_t *inBuffer, int32_t inBytes)
+{
+    uint8_t *buf = (uint8_t *)malloc(WINDOW + inBytes);
+    hash_chain_state *st = (hash_chain_state *)malloc(sizeof(hash_chain_state));
+    if (!buf || !st)
+    {
+        free(buf);
+        free(st);
+        return NULL;
+    }
+
+    memset(buf, 0x20, WINDOW);
+    memcpy(&buf[WINDOW], inBuffer, inBytes);
+    st->buf = buf;
+    st->end = WINDOW + inBytes;
+    memset(st->head, 0xFF, sizeof(st->head));
+
+    for (int32_t k = 0; k < WINDOW; k++)
+    {
+        hc_insert(st, k);
+    }
+
+    return st;
+}
+
+static void hc_free(hash_chain_state *st)
+{
+    free((void *)st->buf);
+    free(st);
+}
+
+static int32_t compress_hash_chain(uint8_t *outBuffer, int32_t outBytes,
+                                   const uint8_t *inBuffer, int32_t inBytes,
+                                   const compress_options_t *options)
+{
+    uint32_t depth = options->chainDepth ? options->chainDepth : COMPRESS_DEFAULT_CHAIN_DEPTH;
+    int niceLen = (options->niceLength && options->niceLength < F) ? options->niceLength : F;
+
+    hash_chain_state *st = hc_init(inBuffer, inBytes);
+    if (!st)
+    {
+        return -1;
+    }
+
+    code_writer w;
+    writer_init(&w, outBuffer, outBytes);
+
+    bool ok = true;
+    int32_t k = WINDOW;
+    while (ok && k < st->end)
+    {
+        int maxLen = (st->end - k < F) ? st->end - k : F;
+        int32_t matchPos = 0;
+        int len = hc_find(st, k, maxLen, depth, niceLen, &matchPos);
+
+        if (len)
+        {
+            ok = writer_reference(&w, matchPos & (N-1), len);
+        }
+        else
+        {
+            ok = writer_literal(&w, st->buf[k]);
+            len = 1;
+        }
+
+        while (len--)
+        {
+            hc_insert(st, k++);
+        }
+    }
+
+    ok = ok && writer_flush(&w);
+
+    hc_free(st);
+
+    return ok ? w.written : -1;
+}
+
+// Each unit costs its flag bit in the control byte plus its payload.
+#define LITERAL_BITS    (1 + 8)
+#define REFERENCE_BITS  (1 + 16)
+
+static int32_t compress_optimal(uint8_t *outBuffer, int32_t outBytes,
+                                const uint8_t *inBuffer, int32_t inBytes,
+                                const compress_options_t *options)
+{
+    // Every reference costs the same regardless of distance, so the longest
+    // match at each position (and all of its prefixes) is the only candidate
+    // the parse needs.
+    uint32_t depth = options->chainDepth ? options->chainDepth : N;
+
+    hash_chain_state *st = hc_init(inBuffer, inBytes);
+    uint8_t *matchLen = (uint8_t *)malloc(inBytes);
+    int32_t *matchPos = (int32_t *)malloc(inBytes * sizeof(int32_t));
+    uint32_t *cost = (uint32_t *)malloc((inBytes + 1) * sizeof(uint32_t));
+    if (!st || !matchLen || !matchPos || !cost)
+    {
+        if (st)
+        {
+            hc_free(st);
+        }
+        free(matchLen);
+        free(matchPos);
+        free(cost);
+        return -1;
+    }
+
+    for (int32_t i = 0; i < inBytes; i++)
+    {
+        int32_t k = WINDOW + i;
+        int maxLen = (inBytes - i < F) ? inBytes - i : F;
+        matchLen[i] = hc_find(st, k, maxLen, depth, F, &matchPos[i]);
+        hc_insert(st, k);
+    }
+
+    // cost[i] is the smallest encoding of the input from i onwards, and
+    // matchLen[i] is rewritten to the length of the unit chosen at i.
+    cost[inBytes] = 0;
+    for (int32_t i = inBytes - 1; i >= 0; i--)
+    {
+        int best = 1;
+        cost[i] = LITERAL_BITS + cost[i + 1];
+        for (int len = THRESHOLD + 1; len <= matchLen[i]; len++)
+        {
+            uint32_t c = REFERENCE_BITS + cost[i + len];
+            if (c < cost[i])
+            {
+                cost[i] = c;
+                best = len;
+            }
+        }
+        matchLen[i] = best;
+    }
+
+    code_writer w;
+    writer_init(&w, outBuffer, outBytes);
+
+    bool ok = true;
+    for (int32_t i = 0; ok && i < inBytes; i += matchLen[i])
+    {
+        if (matchLen[i] > THRESHOLD)
+        {
+            ok = writer_reference(&w, matchPos[i] & (N-1), matchLen[i]);
+        }
+        else
+        {
+            ok = writer_literal(&w, inBuffer[i]);
+        }
+    }
+
+    ok = ok && writer_flush(&w);
+
+    hc_free(st);
+    free(matchLen);
+    free(matchPos);
+    free(cost);
+
+    return ok ? w.written : -1;
+}
+
+int32_t compress_ex(uint8_t *outBuffer, int32_t outBytes,
+                    const uint8_t *inBuffer, int32_t inBytes,
+                    const compress_options_t *options)
+{
+    if (!inBytes)
+    {
+        return -1;
+    }
+
+    if (options && COMPRESS_OPTIMAL == options->parse)
+    {
+        return compress_optimal(outBuffer, outBytes, inBuffer, inBytes, options);
+    }
+    else if (options && COMPRESS_HASH_CHAIN == options->finder)
+    {
+        return compress_hash_chain(outBuffer, outBytes, inBuffer, inBytes, options);
+    }
+
+    return compress(outBuffer, outBytes, inBuffer, inBytes);
+}
@@ -44,128 +44,272 @@
 
 #include <Compress.h>
 
-#include <stdio.h>
-
 #define DICTIONARY_INIT_0x20   (0x20)
 #define DICTIONARY_INIT_0x00   (0x00)
 #define DICTIONARY_INIT_INDEX  (2014)
-#define DICTIONARY_SIZE        (2048)
+#define DICTIONARY_SIZE        DECOMPRESS_DICTIONARY_SIZE
 
 #define LITERAL_TYPE    (1)
 #define REFERENCE_TYPE  (0)
 
-static struct {
-    uint8_t dictionary[DICTIONARY_SIZE];
-    uint32_t cursor;
-    const uint8_t* inBuffer;
-    int32_t inBytes;
+static void state_insert(decompress_ctx* ctx, uint8_t byte)
+{
+    ctx->dictionary[ctx->cursor] = byte;
+    // Increment and wrap.
+    ctx->cursor = (ctx->cursor + 1) % DICTIONARY_SIZE;
+}
 
-    uint8_t* outBuffer;
-    int32_t outRemaining;
-    int32_t outSent;
-} g_DecompressorState;
+static uint8_t state_get_dictionary(decompress_ctx* ctx, uint16_t offset)
+{
+    offset = offset % DICTIONARY_SIZE;
+    return ctx->dictionary[offset];
+}
 
+static void state_output(decompress_ctx* ctx, uint8_t literal)
+{
+    state_insert(ctx, literal);
+    ctx->outBuffer[ctx->outSent++] = literal;
+}
 
-static void state_init(const uint8_t* inBuffer, int32_t inBytes)
+void decompress_init(decompress_ctx* ctx, uint8_t* outBuffer, int32_t outBytes)
 {
-    g_DecompressorState.cursor = DICTIONARY_INIT_INDEX;
+    ctx->cursor = DICTIONARY_INIT_INDEX;
     int i = 0;
-    for(; i < g_DecompressorState.cursor; i++)
+    for(; i < DICTIONARY_INIT_INDEX; i++)
     {
-        g_DecompressorState.dictionary[i] = DICTIONARY_INIT_0x20;
+        ctx->dictionary[i] = DICTIONARY_INIT_0x20;
     }
 
     for(; i < DICTIONARY_SIZE; i++)
     {
-        g_DecompressorState.dictionary[i] = DICTIONARY_INIT_0x00;
+        ctx->dictionary[i] = DICTIONARY_INIT_0x00;
     }
 
-    g_DecompressorState.inBuffer = inBuffer;
-    g_DecompressorState.inBytes = inBytes;
+    ctx->control = 0;
+    ctx->units = 0;
+    ctx->reference = 0;
+    ctx->referenceSplit = 0;
+
+    ctx->outBuffer = outBuffer;
+    ctx->outBytes = outBytes;
+    ctx->outSent = 0;
 }
 
-static void state_insert(uint8_t byte)
+int32_t decompress_feed(decompress_ctx* ctx, const uint8_t* inBuffer, int32_t inBytes)
 {
-    g_DecompressorState.dictionary[g_DecompressorState.cursor] = byte;
-    // Increment and wrap.
-    g_DecompressorState.cursor = (g_DecompressorState.cursor + 1) % DICTIONARY_SIZE;
+    int32_t start = ctx->outSent;
+
+    while(inBytes > 0 && ctx->outSent < ctx->outBytes)
+    {
+        uint8_t byte = *inBuffer++;
+        inBytes--;
+
+        if(!ctx->units)
+        {
+            // Each control byte describes the next eight units.
+            ctx->control = byte;
+            ctx->units = 8;
+            continue;
+        }
+
+        if((ctx->control & 1) == REFERENCE_TYPE)
+        {
+            if(!ctx->referenceSplit)
+            {
+                // The second reference byte may be in the next chunk.
+                ctx->reference = byte;
+                ctx->referenceSplit = 1;
+                continue;
+            }
+
+            uint8_t B0 = ctx->reference;
+            uint8_t B1 = byte;
+
+            uint16_t offset = (((uint16_t)B1 & 0xE0u) << 3u) | B0;
+            uint16_t length = (B1 & 0x1Fu) + 3u;
+
+            while(length && ctx->outSent < ctx->outBytes)
+            {
+                state_output(ctx, state_get_dictionary(ctx, offset));
+
+                offset++;
+                length--;
+            }
+
+            ctx->referenceSplit = 0;
+        }
+        else /* LITERAL_TYPE */
+        {
+            state_output(ctx, byte);
+        }
+
+        ctx->control >>= 1;
+        ctx->units--;
+    }
+
+    return ctx->outSent - start;
 }
 
-static uint8_t state_get_dictionary(uint16_t offset)
+int32_t decompress_finish(decompress_ctx* ctx)
 {
-    offset = offset % DICTIONARY_SIZE;
-    return g_DecompressorState.dictionary[offset];
+    // A reference cut short by the end of the input is dropped.
+    ctx->referenceSplit = 0;
+
+    return ctx->outSent;
 }
 
-static uint8_t state_get_byte(void)
+int32_t decompress(uint8_t* outBuffer, int32_t outBytes,
+                   const uint8_t* inBuffer,  int32_t inBytes)
 {
-    // uint8_t bytesLeft = g_DecompressorState.inBytes;
-    uint8_t byte = 0;
-    // if(bytesLeft > 0)
-    // {
-        byte = *g_DecompressorState.inBuffer;
-        g_DecompressorState.inBuffer++;
-        g_DecompressorState.inBytes--;
-    // }
-
-    return byte;
+    decompress_ctx ctx;
+
+    decompress_init(&ctx, outBuffer, outBytes);
+    decompress_feed(&ctx, inBuffer, inBytes);
+
+    return decompress_finish(&ctx);
 }
 
-int32_t state_bytes_left(void)
+#define DICTIONARY_MASK        (DICTIONARY_SIZE - 1)
+
+#if defined(__x86_64__) || defined(__aarch64__)
+typedef uint64_t copy_word_t;
+#else
+typedef uint32_t copy_word_t;
+#endif
+
+// Forward copy a word at a time. Overlapping copies are only correct if dst
+// is at least a word past src.
+static inline void copy_words(uint8_t* dst, const uint8_t* src, int32_t length)
 {
-    return g_DecompressorState.inBytes;
+    if(length < (int32_t)sizeof(copy_word_t))
+    {
+        if(sizeof(copy_word_t) > sizeof(uint32_t) && length >= (int32_t)sizeof(uint32_t))
+        {
+            // Two, possibly overlapping, half words cover it.
+            uint32_t head, tail;
+            __builtin_memcpy(&head, src, sizeof(head));
+            __builtin_memcpy(&tail, src + length - sizeof(tail), sizeof(tail));
+            __builtin_memcpy(dst, &head, sizeof(head));
+            __builtin_memcpy(dst + length - sizeof(tail), &tail, sizeof(tail));
+            return;
+        }
+
+        while(length--)
+        {
+            *dst++ = *src++;
+        }
+        return;
+    }
+
+    const uint8_t* srcLast = src + length - sizeof(copy_word_t);
+    uint8_t* dstLast = dst + length - sizeof(copy_word_t);
+    copy_word_t word;
+
+    while(length >= (int32_t)sizeof(copy_word_t))
+    {
+        __builtin_memcpy(&word, src, sizeof(word));
+        __builtin_memcpy(dst, &word, sizeof(word));
+        dst += sizeof(word);
+        src += sizeof(word);
+        length -= sizeof(word);
+    }
+
+    if(length)
+    {
+        // Finish with a word ending on the last byte, rewriting some bytes
+        // with the values they already hold.
+        __builtin_memcpy(&word, srcLast, sizeof(word));
+        __builtin_memcpy(dstLast, &word, sizeof(word));
+    }
 }
 
-int32_t decompress(uint8_t* outBuffer, int32_t outBytes,
-                   const uint8_t* inBuffer,  int32_t inBytes)
+int32_t decompress_fast(uint8_t* outBuffer, int32_t outBytes,
+                        const uint8_t* inBuffer, int32_t inBytes)
 {
+    const uint8_t* inEnd = inBuffer + inBytes;
     int32_t actualSize = 0;
-    state_init(inBuffer, inBytes);
 
-    while(state_bytes_left() > 0)
+    while(inBuffer < inEnd && actualSize < outBytes)
     {
-        uint8_t control = state_get_byte();
-        for(int i = 0; i < 8; i++)
+        uint32_t control = *inBuffer++;
+        int unit = 0;
+
+        while(unit < 8 && inBuffer < inEnd && actualSize < outBytes)
         {
-            if(actualSize >= outBytes || !state_bytes_left())
+            if((control & 1) == LITERAL_TYPE)
             {
-                // We have no bytes left, or we've filled up the output buffer
-                break;
-            }
+                // Copy the whole run of literals at once. The flags above the
+                // remaining units are zero, which bounds the run.
+                int32_t run = __builtin_ctz(~control);
+                if(run > inEnd - inBuffer)
+                {
+                    run = inEnd - inBuffer;
+                }
+                if(run > outBytes - actualSize)
+                {
+                    run = outBytes - actualSize;
+                }
 
-            if((control & (1 << i)) == REFERENCE_TYPE)
+                copy_words(&outBuffer[actualSize], inBuffer, run);
+                actualSize += run;
+                inBuffer += run;
+                control >>= run;
+                unit += run;
+            }
+            else /* REFERENCE_TYPE */
             {
-                // Read in two reference bytes
-                uint8_t B0 = state_get_byte();
-                uint8_t B1 = state_get_byte();
+                if(inEnd - inBuffer < 2)
+                {
+                    // Truncated reference.
+                    inBuffer = inEnd;
+                    break;
+                }
 
-                uint16_t offset = (((uint16_t)B1 & 0xE0u) << 3u) | B0;
-                uint16_t length = (B1 & 0x1Fu) + 3u;
+                uint8_t B0 = *inBuffer++;
+                uint8_t B1 = *inBuffer++;
 
-                while(length && actualSize < outBytes)
+                uint32_t offset = (((uint32_t)B1 & 0xE0u) << 3u) | B0;
+                int32_t length = (B1 & 0x1Fu) + 3u;
+                if(length > outBytes - actualSize)
                 {
-                    uint8_t literal = state_get_dictionary(offset);
-                    state_insert(literal);
+                    length = outBytes - actualSize;
+                }
 
+                // The output is the window: dictionary slot (INDEX + n) holds
+                // output byte n, so the reference starts distance bytes back.
+                uint32_t cursor = (DICTIONARY_INIT_INDEX + actualSize) & DICTIONARY_MASK;
+                int32_t distance = ((cursor - offset - 1) & DICTIONARY_MASK) + 1;
+                int32_t source = actualSize - distance;
+
+                // Slots not written yet still hold their initial value.
+                while(length && source < 0)
+                {
+                    outBuffer[actualSize++] = ((offset & DICTIONARY_MASK) < DICTIONARY_INIT_INDEX) ?
+                                              DICTIONARY_INIT_0x20 : DICTIONARY_INIT_0x00;
                     offset++;
+                    source++;
                     length--;
-                    outBuffer[actualSize++] = literal;
                 }
-            }
-            else /* LITERAL_TYPE */
-            {
-                uint8_t literal = state_get_byte();;
-                state_insert(literal);
 
-                // Output
-                outBuffer[actualSize++] = literal;
+                if(distance >= (int32_t)sizeof(copy_word_t))
+                {
+                    copy_words(&outBuffer[actualSize], &outBuffer[source], length);
+                }
+                else
+                {
+                    // Short distances repeat a pattern, one byte at a time.
+                    for(int32_t i = 0; i < length; i++)
+                    {
+                        outBuffer[actualSize + i] = outBuffer[source + i];
+                    }
+                }
+                actualSize += length;
 
+                control >>= 1;
+                unit++;
             }
         }
     }
 
-    // printf("inBytes: %d (%d left), outBytes: %d, actualSize: %d\n", inBytes, state_bytes_left(), outBytes, actualSize);
-    // while(1);
-
     return actualSize;
 }
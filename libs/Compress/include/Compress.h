@@ -55,9 +55,102 @@ extern "C" {
 int32_t decompress(  uint8_t* outBuffer, int32_t outBytes,
                     const uint8_t* inBuffer,  int32_t inBytes);
 
+#define DECOMPRESS_DICTIONARY_SIZE     (2048)
+
+/** @brief State of a decompression in progress, see decompress_init(). */
+typedef struct {
+    uint8_t dictionary[DECOMPRESS_DICTIONARY_SIZE];
+    uint32_t cursor;
+
+    uint8_t control;        /**< Remaining flags of the current control byte. */
+    uint8_t units;          /**< Units left in the current control byte. */
+    uint8_t reference;      /**< First byte of a reference split across feeds. */
+    uint8_t referenceSplit;
+
+    uint8_t* outBuffer;
+    int32_t outBytes;
+    int32_t outSent;
+} decompress_ctx;
+
+/**
+ * @brief Starts decompressing into @p outBuffer, at most @p outBytes.
+ *
+ * Contexts are independent, so several streams may be decoded at once.
+ */
+void decompress_init(decompress_ctx* ctx, uint8_t* outBuffer, int32_t outBytes);
+
+/**
+ * @brief Decodes the next chunk of compressed input. Chunks may split
+ *        control bytes and references at any point.
+ *
+ * @returns the number of bytes output for this chunk.
+ */
+int32_t decompress_feed(decompress_ctx* ctx, const uint8_t* inBuffer, int32_t inBytes);
+
+/** @returns the total number of bytes output. */
+int32_t decompress_finish(decompress_ctx* ctx);
+
+/**
+ * @brief decompress() without an intermediate dictionary.
+ *
+ * Decodes straight into @p outBuffer, using the output as the window, and
+ * copies literal runs and references in words. The result is identical to
+ * decompress().
+ */
+int32_t decompress_fast(uint8_t* outBuffer, int32_t outBytes,
+                        const uint8_t* inBuffer, int32_t inBytes);
+
+/**
+ * @brief Compresses with binary search trees, always finding the longest match.
+ *
+ * @returns the number of bytes written or -1 if the output did not fit.
+ */
 int32_t compress(  uint8_t* outBuffer, int32_t outBytes,
                     const uint8_t* inBuffer,  int32_t inBytes);
 
+typedef enum {
+    /** @brief Binary search trees, always finds the longest match. */
+    COMPRESS_TREE,
+    /** @brief Hash chains, searching at most chainDepth candidates. */
+    COMPRESS_HASH_CHAIN,
+} compress_finder_t;
+
+typedef enum {
+    /** @brief Take the longest match at each position. */
+    COMPRESS_GREEDY,
+    /** @brief Choose literals and matches to minimize the output size.
+     *         Always uses hash chains, by default searching the whole window. */
+    COMPRESS_OPTIMAL,
+} compress_parse_t;
+
+#define COMPRESS_DEFAULT_CHAIN_DEPTH   (64)
+
+typedef struct {
+    compress_finder_t finder;
+
+    /** @brief Candidates examined per position, 0 selects the default.
+     *         Lower is faster, higher compresses better. */
+    uint32_t chainDepth;
+
+    /** @brief Stop searching once a match this long is found, 0 for F. */
+    uint32_t niceLength;
+
+    compress_parse_t parse;
+} compress_options_t;
+
+/**
+ * @brief compress() with a selectable match finder.
+ *
+ * The output is decoded by decompress() regardless of the options used.
+ *
+ * @param options   Finder and tuning, NULL selects compress().
+ *
+ * @returns the number of bytes written or -1 if the output did not fit.
+ */
+int32_t compress_ex(uint8_t* outBuffer, int32_t outBytes,
+                    const uint8_t* inBuffer, int32_t inBytes,
+                    const compress_options_t* options);
+
 #ifdef __cplusplus
 }
 #endif
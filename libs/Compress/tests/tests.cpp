@@ -0,0 +1,149 @@
+#include "gtest/gtest.h"
+#include <Compress.h>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+TEST(Compress, RoundTrip) {
+    // Repetitive data with some noise, starting with spaces to exercise
+    // matches against the initial dictionary.
+    std::vector<uint8_t> input(20000);
+    uint32_t seed = 1;
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        if (i < 64)
+        {
+            input[i] = ' ';
+        }
+        else if ((seed >> 16) % 8)
+        {
+            input[i] = input[i - 1 - (seed >> 20) % 1500];
+        }
+        else
+        {
+            input[i] = seed >> 24;
+        }
+    }
+
+    std::vector<uint8_t> compressed(input.size() * 2);
+    std::vector<uint8_t> output(input.size());
+    int32_t tree = compress(compressed.data(), compressed.size(), input.data(), input.size());
+
+    for (uint32_t depth = 1; depth <= 256; depth *= 16)
+    {
+        compress_options_t options = { COMPRESS_HASH_CHAIN, depth, 0 };
+        int32_t size = compress_ex(compressed.data(), compressed.size(), input.data(), input.size(), &options);
+        ASSERT_GT(size, 0);
+        EXPECT_LT(size, tree * 11 / 10);
+
+        EXPECT_EQ(decompress(output.data(), output.size(), compressed.data(), size), (int32_t)input.size());
+        EXPECT_TRUE(output == input);
+    }
+
+    // The optimal parse is never worse than the greedy longest match, up to
+    // rounding of the final control byte.
+    compress_options_t best = { COMPRESS_HASH_CHAIN, 0, 0, COMPRESS_OPTIMAL };
+    int32_t size = compress_ex(compressed.data(), compressed.size(), input.data(), input.size(), &best);
+    ASSERT_GT(size, 0);
+    EXPECT_LE(size, tree + 1);
+    EXPECT_EQ(decompress(output.data(), output.size(), compressed.data(), size), (int32_t)input.size());
+    EXPECT_TRUE(output == input);
+
+    // Output that does not fit is reported instead of overrunning.
+    compress_options_t options = { COMPRESS_HASH_CHAIN, 0, 0 };
+    EXPECT_EQ(compress_ex(compressed.data(), 100, input.data(), input.size(), &options), -1);
+    EXPECT_EQ(compress_ex(compressed.data(), 100, input.data(), input.size(), &best), -1);
+    options.finder = COMPRESS_TREE;
+    EXPECT_EQ(compress_ex(compressed.data(), 100, input.data(), input.size(), &options), -1);
+}
+
+TEST(Compress, StreamingDecompress) {
+    std::vector<uint8_t> input(8000);
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = (i % 97 < 60) ? "bcm5719 ape "[i % 12] : (uint8_t)(i * 7);
+    }
+
+    std::vector<uint8_t> compressed(input.size() * 2);
+    int32_t size = compress(compressed.data(), compressed.size(), input.data(), input.size());
+    ASSERT_GT(size, 0);
+
+    // Two interleaved streams fed in uneven chunks, splitting control bytes
+    // and references.
+    std::vector<uint8_t> output[2];
+    decompress_ctx ctx[2];
+    for (int s = 0; s < 2; s++)
+    {
+        output[s].resize(input.size());
+        decompress_init(&ctx[s], output[s].data(), output[s].size());
+    }
+
+    int32_t offset = 0;
+    for (int32_t chunk = 1; offset < size; chunk = chunk % 7 + 1)
+    {
+        int32_t bytes = std::min(chunk, size - offset);
+        for (int s = 0; s < 2; s++)
+        {
+            decompress_feed(&ctx[s], &compressed[offset], bytes);
+        }
+        offset += bytes;
+    }
+
+    for (int s = 0; s < 2; s++)
+    {
+        EXPECT_EQ(decompress_finish(&ctx[s]), (int32_t)input.size());
+        EXPECT_TRUE(output[s] == input);
+    }
+}
+
+TEST(Compress, FastDecoderFuzz) {
+    uint32_t seed = 5719;
+    for (int iteration = 0; iteration < 200; iteration++)
+    {
+        std::vector<uint8_t> input(1 + (seed >> 8) % 6000);
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            if (i > 4 && (seed >> 16) % 4)
+            {
+                input[i] = input[i - 1 - (seed >> 18) % std::min<size_t>(i, 3000)];
+            }
+            else
+            {
+                input[i] = (iteration & 1) ? ' ' + (seed >> 28) : seed >> 24;
+            }
+        }
+
+        std::vector<uint8_t> compressed(input.size() * 2 + 16);
+        compress_options_t options = { COMPRESS_HASH_CHAIN, 0, 0, (iteration & 2) ? COMPRESS_OPTIMAL : COMPRESS_GREEDY };
+        int32_t size = compress_ex(compressed.data(), compressed.size(), input.data(), input.size(), &options);
+        ASSERT_GT(size, 0);
+
+        // Valid streams round trip, corrupted or truncated ones must still
+        // decode exactly as the reference decoder does.
+        if (iteration % 3 == 1)
+        {
+            compressed[(seed >> 4) % size] ^= 1 << (seed % 8);
+        }
+        if (iteration % 5 == 2)
+        {
+            size -= 1 + (seed >> 12) % std::min(size, 16);
+        }
+
+        std::vector<uint8_t> reference(input.size() + 64, 0xAA);
+        std::vector<uint8_t> fast(input.size() + 64, 0xAA);
+        int32_t outBytes = (iteration % 7 == 3) ? input.size() / 2 : input.size() + 64;
+        int32_t expected = decompress(reference.data(), outBytes, compressed.data(), size);
+        EXPECT_EQ(decompress_fast(fast.data(), outBytes, compressed.data(), size), expected);
+        EXPECT_TRUE(fast == reference) << "iteration " << iteration;
+
+        if (iteration % 3 != 1 && iteration % 5 != 2 && outBytes > (int32_t)input.size())
+        {
+            EXPECT_TRUE(std::equal(input.begin(), input.end(), fast.begin()));
+        }
+    }
+}
+
+}  // namespace
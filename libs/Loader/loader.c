@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       loader.c
+///
+/// @project
+///
+/// @brief      APE loader command handlers
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2018, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Loader.h>
+
+#include <APE_SHM.h>
+#include <types.h>
+#include <ape_loader_ring.h>
+#include <Compress.h>
+#include <NVRam.h>
+
+static inline uint32_t loaderBlockWords(uint32_t bytes)
+{
+    uint32_t words = bytes / 4;
+    if(words > ARRAY_ELEMENTS(SHM.LoaderBuffer))
+    {
+        words = ARRAY_ELEMENTS(SHM.LoaderBuffer);
+    }
+    return words;
+}
+
+static uint32_t loaderExecute(uint32_t command, uint32_t arg0, uint32_t arg1)
+{
+    uint32_t result = 0;
+
+    switch(command)
+    {
+        default:
+            break;
+
+        case SHM_LOADER_COMMAND_COMMAND_READ_MEM:
+        {
+            // Read word address specified in arg0
+            uint32_t* addr = ((void*)arg0);
+            result = *addr;
+            break;
+        }
+        case SHM_LOADER_COMMAND_COMMAND_WRITE_MEM:
+        {
+            // Write word address specified in arg0 with arg1
+            uint32_t* addr = ((void*)arg0);
+            *addr = arg1;
+            break;
+        }
+        case SHM_LOADER_COMMAND_COMMAND_READ_BLOCK:
+        {
+            // Copy arg1 bytes starting at arg0 into the staging buffer.
+            uint32_t* addr = ((void*)arg0);
+            uint32_t words = loaderBlockWords(arg1);
+            for(int i = 0; i < words; i++)
+            {
+                SHM.LoaderBuffer[i].r32 = addr[i];
+            }
+            break;
+        }
+        case SHM_LOADER_COMMAND_COMMAND_WRITE_BLOCK:
+        {
+            // Copy arg1 bytes from the staging buffer to arg0.
+            uint32_t* addr = ((void*)arg0);
+            uint32_t words = loaderBlockWords(arg1);
+            for(int i = 0; i < words; i++)
+            {
+                addr[i] = SHM.LoaderBuffer[i].r32;
+            }
+            break;
+        }
+        case SHM_LOADER_COMMAND_COMMAND_MEMSET:
+        {
+            // Fill arg1 bytes starting at arg0 with the first staging word.
+            uint32_t* addr = ((void*)arg0);
+            uint32_t value = SHM.LoaderBuffer[0].r32;
+            for(int i = 0; i < arg1 / 4; i++)
+            {
+                addr[i] = value;
+            }
+            break;
+        }
+        case SHM_LOADER_COMMAND_COMMAND_DECOMPRESS:
+        {
+            // Expand the LZSS stream in the staging buffer to arg0. The low
+            // half of arg1 is the compressed length, the high half is the
+            // maximum decompressed length.
+            uint8_t* addr = ((void*)arg0);
+            uint32_t inBytes = arg1 & 0xFFFF;
+            if(inBytes > sizeof(SHM.LoaderBuffer))
+            {
+                inBytes = sizeof(SHM.LoaderBuffer);
+            }
+            result = decompress_fast(addr, arg1 >> 16,
+                                     (const uint8_t*)&SHM.LoaderBuffer[0], inBytes);
+            break;
+        }
+        case SHM_LOADER_COMMAND_COMMAND_CRC:
+        {
+            // CRC of arg1 bytes starting at arg0.
+            const uint8_t* addr = ((void*)arg0);
+            result = NVRam_crc(addr, arg1, 0xffffffff);
+            break;
+        }
+        case SHM_LOADER_COMMAND_COMMAND_CALL:
+        {
+            // call address specified in arg0.
+            void (*function)(uint32_t) = ((void*)arg0);
+            function(arg1);
+            break;
+        }
+    }
+
+    return result;
+}
+
+static volatile APELoaderRing_t* loaderInitRing(void)
+{
+    volatile APELoaderRing_t* ring = (void*)((uint8_t*)&SHM + APE_LOADER_RING_OFFSET);
+
+    ring->producer = 0;
+    ring->consumer = 0;
+    ring->entries = APE_LOADER_RING_ENTRIES;
+
+    SHM.SegMessageBufferOffset.r32 = APE_LOADER_RING_OFFSET;
+    SHM.SegMessageBufferLength.r32 = sizeof(APELoaderRing_t);
+
+    return ring;
+}
+
+static void loaderDrainRing(volatile APELoaderRing_t* ring)
+{
+    uint32_t consumer = ring->consumer;
+    uint32_t producer = ring->producer;
+
+    // Handle everything queued so far, then publish the new consumer once.
+    while(consumer != producer && producer < APE_LOADER_RING_ENTRIES)
+    {
+        volatile APELoaderRingEntry_t* entry = &ring->entry[consumer];
+        entry->result = loaderExecute(entry->command, entry->arg0, entry->arg1);
+
+        if(++consumer == APE_LOADER_RING_ENTRIES)
+        {
+            consumer = 0;
+        }
+    }
+
+    ring->consumer = consumer;
+}
+
+void __attribute__((noreturn)) loaderLoop(void)
+{
+    volatile APELoaderRing_t* ring = loaderInitRing();
+
+    // Update SHM.Sig to signal ready.
+    SHM.SegSig.bits.Sig = SHM_SEG_SIG_SIG_LOADER;
+    SHM.FwStatus.bits.Ready = 1;
+
+    for(;;)
+    {
+        loaderDrainRing(ring);
+
+        uint32_t command = SHM.LoaderCommand.bits.Command;
+        if(!command) continue;
+
+        uint32_t result = loaderExecute(command, SHM.LoaderArg0.r32, SHM.LoaderArg1.r32);
+        if(SHM_LOADER_COMMAND_COMMAND_READ_MEM == command ||
+           SHM_LOADER_COMMAND_COMMAND_DECOMPRESS == command ||
+           SHM_LOADER_COMMAND_COMMAND_CRC == command)
+        {
+            SHM.LoaderArg0.r32 = result;
+        }
+
+        // Mark command as handled.
+        SHM.LoaderCommand.bits.Command = 0;
+    }
+}
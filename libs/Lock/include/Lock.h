@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       Lock.h
+///
+/// @project
+///
+/// @brief      Bounded hardware lock routines
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LOCK_H
+#define LOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum
+{
+    /** @brief APE per-function PHY lock, PerLockRequestPhyN/PerLockGrantPhyN. */
+    LOCK_APE,
+    /** @brief NVM software arbitration. */
+    LOCK_NVM,
+    /** @brief GRC MutexRequest/MutexGrant, bit 4. */
+    LOCK_GRC_MUTEX,
+    LOCK_COUNT
+} LockId_t;
+
+typedef struct
+{
+    uint32_t acquisitions;
+    uint32_t contended; /**< Acquisitions that were not granted immediately. */
+    uint32_t timeouts;
+    uint32_t spins;     /**< Grant polls after the first one. */
+    uint32_t maxSpins;
+    uint32_t maxWait;   /**< Longest wait, in microseconds. */
+} LockStats_t;
+
+#ifdef CXX_SIMULATOR
+/** @brief Busy polls before the host starts sleeping between polls. */
+#define LOCK_BACKOFF_SPINS (16u)
+/** @brief Longest sleep between polls on the host, in microseconds. */
+#define LOCK_BACKOFF_MAX (1024u)
+/** @brief Default spin limit, about 5 seconds once backed off. */
+#define LOCK_TIMEOUT_SPINS (5000u)
+#else
+/** @brief Default spin limit, well over any legitimate hold time. */
+#define LOCK_TIMEOUT_SPINS (1u << 20)
+#endif
+
+/**
+ * @brief Requests @p lock and polls for the grant.
+ *
+ * @param maxSpins  Number of polls before giving up.
+ *
+ * @returns false if the lock was not granted in time, the request is
+ *          withdrawn in that case.
+ */
+bool Lock_acquire(LockId_t lock, uint32_t maxSpins);
+
+void Lock_release(LockId_t lock);
+
+const LockStats_t *Lock_getStats(LockId_t lock);
+void Lock_resetStats(void);
+
+#endif /* LOCK_H */
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       lock.c
+///
+/// @project
+///
+/// @brief      Bounded hardware lock routines
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Lock.h>
+
+#include "../NVRam/bcm5719_NVM.h"
+#include <bcm5719_APE_PERI.h>
+#include <bcm5719_DEVICE.h>
+
+#ifdef CXX_SIMULATOR
+#include <time.h>
+#define REQ ReqSet2
+#define CLR ReqClr2
+#define WON ArbWon2
+typedef BCM5719_APE_PERI_H_uint32_t lock_reg_t;
+#else /* Firmware */
+#define REQ ReqSet0
+#define CLR ReqClr0
+#define WON ArbWon0
+typedef volatile uint32_t lock_reg_t;
+#endif
+
+#define GRC_MUTEX_BIT (1u << 4)
+
+static LockStats_t gLockStats[LOCK_COUNT];
+
+static lock_reg_t *Lock_apeRequest(void)
+{
+    switch (DEVICE.Status.bits.FunctionNumber)
+    {
+        default:
+        case 0:
+            return &APE_PERI.PerLockRequestPhy0.r32;
+        case 1:
+            return &APE_PERI.PerLockRequestPhy1.r32;
+        case 2:
+            return &APE_PERI.PerLockRequestPhy2.r32;
+        case 3:
+            return &APE_PERI.PerLockRequestPhy3.r32;
+    }
+}
+
+static lock_reg_t *Lock_apeGrant(void)
+{
+    switch (DEVICE.Status.bits.FunctionNumber)
+    {
+        default:
+        case 0:
+            return &APE_PERI.PerLockGrantPhy0.r32;
+        case 1:
+            return &APE_PERI.PerLockGrantPhy1.r32;
+        case 2:
+            return &APE_PERI.PerLockGrantPhy2.r32;
+        case 3:
+            return &APE_PERI.PerLockGrantPhy3.r32;
+    }
+}
+
+static uint32_t Lock_apeBit(void)
+{
+    RegAPE_PERIPerLockRequestPhy0_t lock_req;
+    lock_req.r32 = 0;
+    lock_req.bits.Bootcode = 1;
+
+    return lock_req.r32;
+}
+
+static void Lock_request(LockId_t lock)
+{
+    switch (lock)
+    {
+        case LOCK_APE:
+            *Lock_apeRequest() = Lock_apeBit();
+            break;
+
+        case LOCK_NVM:
+        {
+            RegNVMSoftwareArbitration_t req;
+            req.r32 = 0;
+            req.bits.REQ = 1;
+            NVM.SoftwareArbitration = req;
+            break;
+        }
+
+        case LOCK_GRC_MUTEX:
+            DEVICE.MutexRequest.r32 |= GRC_MUTEX_BIT;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static bool Lock_isGranted(LockId_t lock)
+{
+    switch (lock)
+    {
+        case LOCK_APE:
+            return Lock_apeBit() == *Lock_apeGrant();
+
+        case LOCK_NVM:
+            return NVM.SoftwareArbitration.bits.WON;
+
+        case LOCK_GRC_MUTEX:
+            return 0 != (DEVICE.MutexGrant.r32 & GRC_MUTEX_BIT);
+
+        default:
+            return false;
+    }
+}
+
+void Lock_release(LockId_t lock)
+{
+    switch (lock)
+    {
+        case LOCK_APE:
+            // Writing the grant bit releases the lock or cancels the request.
+            *Lock_apeGrant() = Lock_apeBit();
+            break;
+
+        case LOCK_NVM:
+        {
+            RegNVMSoftwareArbitration_t req;
+            req.r32 = 0;
+            req.bits.CLR = 1;
+            NVM.SoftwareArbitration = req;
+            break;
+        }
+
+        case LOCK_GRC_MUTEX:
+            DEVICE.MutexGrant.r32 = GRC_MUTEX_BIT;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static uint32_t Lock_now(void)
+{
+#ifdef CXX_SIMULATOR
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(now.tv_sec * 1000000 + now.tv_nsec / 1000);
+#else
+    return DEVICE.Timer.r32;
+#endif
+}
+
+#ifdef CXX_SIMULATOR
+static void Lock_backoff(uint32_t spins)
+{
+    if (spins < LOCK_BACKOFF_SPINS)
+    {
+        return;
+    }
+
+    // Give the other agents the bus, doubling the delay up to the maximum.
+    uint32_t delay = LOCK_BACKOFF_MAX;
+    if ((spins - LOCK_BACKOFF_SPINS) < 10)
+    {
+        delay = 1u << (spins - LOCK_BACKOFF_SPINS);
+    }
+
+    struct timespec sleep = { 0, (long)delay * 1000 };
+    nanosleep(&sleep, NULL);
+}
+#endif
+
+bool Lock_acquire(LockId_t lock, uint32_t maxSpins)
+{
+    LockStats_t *stats = &gLockStats[lock];
+
+    Lock_request(lock);
+    if (Lock_isGranted(lock))
+    {
+        stats->acquisitions++;
+        return true;
+    }
+
+    // Contended, only now is the wait worth timing.
+    uint32_t start = Lock_now();
+    uint32_t spins = 0;
+    bool granted = false;
+
+    stats->contended++;
+    while (!granted && spins < maxSpins)
+    {
+#ifdef CXX_SIMULATOR
+        Lock_backoff(spins);
+#endif
+        spins++;
+        granted = Lock_isGranted(lock);
+    }
+
+    uint32_t wait = Lock_now() - start;
+    stats->spins += spins;
+    if (spins > stats->maxSpins)
+    {
+        stats->maxSpins = spins;
+    }
+    if (wait > stats->maxWait)
+    {
+        stats->maxWait = wait;
+    }
+
+    if (!granted)
+    {
+        Lock_release(lock);
+        stats->timeouts++;
+        return false;
+    }
+
+    stats->acquisitions++;
+    return true;
+}
+
+const LockStats_t *Lock_getStats(LockId_t lock)
+{
+    return &gLockStats[lock];
+}
+
+void Lock_resetStats(void)
+{
+    for (int i = 0; i < LOCK_COUNT; i++)
+    {
+        LockStats_t empty = { 0 };
+        gLockStats[i] = empty;
+    }
+}
@@ -46,12 +46,235 @@
 
 #define CRC32_POLYNOMIAL 0xEDB88320
 
+#ifdef CXX_SIMULATOR
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRC32_PCLMUL
+#elif defined(__aarch64__) && defined(__linux__)
+#include <arm_acle.h>
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#define CRC32_ARMV8
+#endif
+
+/** @brief Slicing-by-8 tables, gCRCTable[0] is the byte-wise table. */
+static uint32_t gCRCTable[8][256];
+
+static void __attribute__((constructor)) NVRam_crcInitTables(void)
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? CRC32_POLYNOMIAL : 0);
+        }
+        gCRCTable[0][i] = crc;
+    }
+
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        for (int k = 1; k < 8; k++)
+        {
+            uint32_t prev = gCRCTable[k - 1][i];
+            gCRCTable[k][i] = (prev >> 8) ^ gCRCTable[0][prev & 0xFF];
+        }
+    }
+}
+
+uint32_t NVRam_crcSoftware(const uint8_t *pcDatabuf, uint32_t ulDatalen,
+                           uint32_t crc)
+{
+    while (ulDatalen && ((uintptr_t)pcDatabuf & 7))
+    {
+        crc = (crc >> 8) ^ gCRCTable[0][(crc ^ *pcDatabuf++) & 0xFF];
+        ulDatalen--;
+    }
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while (ulDatalen >= 8)
+    {
+        uint32_t one, two;
+        memcpy(&one, pcDatabuf, 4);
+        memcpy(&two, pcDatabuf + 4, 4);
+        one ^= crc;
+
+        crc = gCRCTable[7][one & 0xFF] ^ gCRCTable[6][(one >> 8) & 0xFF] ^
+              gCRCTable[5][(one >> 16) & 0xFF] ^ gCRCTable[4][one >> 24] ^
+              gCRCTable[3][two & 0xFF] ^ gCRCTable[2][(two >> 8) & 0xFF] ^
+              gCRCTable[1][(two >> 16) & 0xFF] ^ gCRCTable[0][two >> 24];
+
+        pcDatabuf += 8;
+        ulDatalen -= 8;
+    }
+#endif
+
+    while (ulDatalen--)
+    {
+        crc = (crc >> 8) ^ gCRCTable[0][(crc ^ *pcDatabuf++) & 0xFF];
+    }
+
+    return crc;
+}
+
+#if defined(CRC32_PCLMUL)
+/**
+ * @brief Folds 64 byte blocks with carry-less multiplies, then reduces the
+ *        remainder with a Barrett reduction.
+ *
+ * @param ulDatalen Must be at least 64 and a multiple of 16.
+ */
+__attribute__((target("pclmul,sse4.1"))) static uint32_t
+NVRam_crcPCLMUL(const uint8_t *pcDatabuf, uint32_t ulDatalen, uint32_t crc)
+{
+    static const uint64_t k1k2[2] __attribute__((aligned(16))) = { 0x0154442bd4, 0x01c6e41596 };
+    static const uint64_t k3k4[2] __attribute__((aligned(16))) = { 0x01751997d0, 0x00ccaa009e };
+    static const uint64_t k5k0[2] __attribute__((aligned(16))) = { 0x0163cd6124, 0x0000000000 };
+    static const uint64_t poly[2] __attribute__((aligned(16))) = { 0x01db710641, 0x01f7011641 };
+
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+    x1 = _mm_loadu_si128((const __m128i *)(pcDatabuf + 0x00));
+    x2 = _mm_loadu_si128((const __m128i *)(pcDatabuf + 0x10));
+    x3 = _mm_loadu_si128((const __m128i *)(pcDatabuf + 0x20));
+    x4 = _mm_loadu_si128((const __m128i *)(pcDatabuf + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(crc));
+
+    x0 = _mm_load_si128((const __m128i *)k1k2);
+    pcDatabuf += 64;
+    ulDatalen -= 64;
+
+    // Fold four 128 bit lanes in parallel.
+    while (ulDatalen >= 64)
+    {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)(pcDatabuf + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(pcDatabuf + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(pcDatabuf + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(pcDatabuf + 0x30)));
+
+        pcDatabuf += 64;
+        ulDatalen -= 64;
+    }
+
+    // Fold the lanes into a single 128 bit value.
+    x0 = _mm_load_si128((const __m128i *)k3k4);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    while (ulDatalen >= 16)
+    {
+        x2 = _mm_loadu_si128((const __m128i *)pcDatabuf);
+
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+        pcDatabuf += 16;
+        ulDatalen -= 16;
+    }
+
+    // Fold 128 bits to 64 bits.
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+
+    x0 = _mm_loadl_epi64((const __m128i *)k5k0);
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits.
+    x0 = _mm_load_si128((const __m128i *)poly);
+
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+#elif defined(CRC32_ARMV8)
+__attribute__((target("+crc"))) static uint32_t
+NVRam_crcARMv8(const uint8_t *pcDatabuf, uint32_t ulDatalen, uint32_t crc)
+{
+    while (ulDatalen >= 8)
+    {
+        uint64_t data;
+        memcpy(&data, pcDatabuf, 8);
+        crc = __crc32d(crc, data);
+        pcDatabuf += 8;
+        ulDatalen -= 8;
+    }
+
+    while (ulDatalen--)
+    {
+        crc = __crc32b(crc, *pcDatabuf++);
+    }
+
+    return crc;
+}
+#endif
+
+uint32_t NVRam_crc(const uint8_t *pcDatabuf, // Pointer to data buffer
+                   uint32_t ulDatalen, // Length of data buffer in bytes
+                   uint32_t crc)       // Initial value
+{
+#if defined(CRC32_PCLMUL)
+    if (ulDatalen >= 64 && __builtin_cpu_supports("pclmul") &&
+        __builtin_cpu_supports("sse4.1"))
+    {
+        uint32_t blocks = ulDatalen & ~15u;
+        crc = NVRam_crcPCLMUL(pcDatabuf, blocks, crc);
+        pcDatabuf += blocks;
+        ulDatalen -= blocks;
+    }
+#elif defined(CRC32_ARMV8)
+    if (getauxval(AT_HWCAP) & HWCAP_CRC32)
+    {
+        return NVRam_crcARMv8(pcDatabuf, ulDatalen, crc);
+    }
+#endif
+
+    return NVRam_crcSoftware(pcDatabuf, ulDatalen, crc);
+}
+
+#elif defined(APE_LOADER)
+
+/*
+ * The APE loader is copied into SHM and run away from its link address
+ * without PIC, so it must not reference .rodata. Use the bitwise loop.
+ */
 uint32_t NVRam_crc(const uint8_t *pcDatabuf, // Pointer to data buffer
                    uint32_t ulDatalen, // Length of data buffer in bytes
                    uint32_t crc)       // Initial value
 {
-    uint8_t data;
-    uint32_t idx, bit;
+    uint32_t idx, bit, data;
     for (idx = 0; idx < ulDatalen; idx++)
     {
         data = *pcDatabuf++;
@@ -63,3 +286,30 @@ uint32_t NVRam_crc(const uint8_t *pcDatabuf, // Pointer to data buffer
 
     return crc;
 }
+
+#else /* Firmware */
+
+/** @brief Nibble-wise table, small enough for the firmware images. */
+static const uint32_t gCRCNibbleTable[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+uint32_t NVRam_crc(const uint8_t *pcDatabuf, // Pointer to data buffer
+                   uint32_t ulDatalen, // Length of data buffer in bytes
+                   uint32_t crc)       // Initial value
+{
+    uint32_t idx;
+    for (idx = 0; idx < ulDatalen; idx++)
+    {
+        crc ^= *pcDatabuf++;
+        crc = (crc >> 4) ^ gCRCNibbleTable[crc & 0xF];
+        crc = (crc >> 4) ^ gCRCNibbleTable[crc & 0xF];
+    }
+
+    return crc;
+}
+
+#endif /* CXX_SIMULATOR */
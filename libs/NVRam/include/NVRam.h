@@ -54,9 +54,102 @@ bool NVRam_releaseLock(void);
 uint32_t NVRam_readWord(uint32_t address);
 void NVRam_read(uint32_t address, uint32_t *buffer, size_t words);
 
+/**
+ * @brief Called for each chunk of NVRam_readStream.
+ *
+ * @param address   NVRAM address of the first word in the chunk.
+ * @param words     The chunk, in the caller's buffer.
+ * @param count     Number of words in the chunk.
+ *
+ * @returns false to stop the stream.
+ */
+typedef bool (*NVRamReadCallback_t)(uint32_t address, uint32_t *words,
+                                    size_t count, void *context);
+
+/**
+ * @brief Reads @p words in bursts of @p chunkWords, calling @p callback as
+ *        each chunk arrives.
+ *
+ * @p buffer is used as a ring when @p bufferWords is smaller than @p words.
+ * @p chunkWords must be non-zero and @p bufferWords a multiple of it, so that
+ * every chunk fits in the buffer without wrapping.
+ *
+ * @returns false if the buffer does not meet the above or the callback
+ *          stopped the stream.
+ */
+bool NVRam_readStream(uint32_t address, size_t words, uint32_t *buffer,
+                      size_t bufferWords, size_t chunkWords,
+                      NVRamReadCallback_t callback, void *context);
+
+/** @brief Stream callback updating the running NVRam_crc in @p context. */
+bool NVRam_crcCallback(uint32_t address, uint32_t *words, size_t count,
+                       void *context);
+
 void NVRam_writeWord(uint32_t address, uint32_t data);
 void NVRam_write(uint32_t address, uint32_t *buffer, size_t words);
 
+/** @brief Size of the NVRAM in bytes. */
+#define NVRAM_SIZE      (1024u * 256u) /* 256KB */
+
+/** @brief Flash page size in bytes, the unit written by a single burst. */
+#define NVRAM_PAGE_SIZE (264u)
+
+/** @brief Number of pages touched by a write of @p words at @p address. */
+#define NVRAM_PAGE_COUNT(address, words)                                        \
+    ((((address) + ((words)*4) + NVRAM_PAGE_SIZE - 1) / NVRAM_PAGE_SIZE) -      \
+     ((address) / NVRAM_PAGE_SIZE))
+
+typedef enum
+{
+    NVRAM_PAGE_UNCHANGED,
+    NVRAM_PAGE_WRITTEN,
+    NVRAM_PAGE_VERIFY_FAILED,
+} NVRamPageStatus_t;
+
+/**
+ * @brief Writes @p words using one First/Last burst per flash page.
+ *
+ * Pages whose contents already match are skipped. If @p status is not NULL
+ * it receives one entry per page touched, see NVRAM_PAGE_COUNT.
+ *
+ * @returns The number of pages written.
+ */
+size_t NVRam_writePages(uint32_t address, const uint32_t *buffer, size_t words,
+                        NVRamPageStatus_t *status);
+
+/**
+ * @brief Programs only the pages where @p buffer differs from @p before.
+ *
+ * @p before must hold the current flash contents, as no flash reads are used
+ * to find dirty pages. Each programmed page is read back and marked
+ * NVRAM_PAGE_VERIFY_FAILED in @p status if it does not match.
+ *
+ * @returns The number of pages written.
+ */
+size_t NVRam_writeChanged(uint32_t address, const uint32_t *before,
+                          const uint32_t *buffer, size_t words,
+                          NVRamPageStatus_t *status);
+
+#ifdef CXX_SIMULATOR
+typedef struct
+{
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t pagesRead;
+} NVRamCacheStats_t;
+
+/**
+ * @brief Serves NVRam_read and NVRam_readWord from a page cache.
+ *
+ * Pages are read with sequential read-ahead and dropped when written through
+ * this library. Changes made by other NVRAM agents are not seen until
+ * NVRam_invalidateCache is called.
+ */
+void NVRam_enableCache(bool enable);
+void NVRam_invalidateCache(void);
+const NVRamCacheStats_t *NVRam_getCacheStats(void);
+#endif
+
 void NVRam_enable(void);
 void NVRam_enableWrites(void);
 void NVRam_disable(void);
@@ -66,4 +159,10 @@ uint32_t NVRam_crc(const uint8_t *pcDatabuf, // Pointer to data buffer
                    uint32_t ulDatalen, // Length of data buffer in bytes
                    uint32_t crc);      // Initial value
 
+#ifdef CXX_SIMULATOR
+/** @brief Table driven NVRam_crc, without any hardware acceleration. */
+uint32_t NVRam_crcSoftware(const uint8_t *pcDatabuf, uint32_t ulDatalen,
+                           uint32_t crc);
+#endif
+
 #endif /* NVRAM_H */
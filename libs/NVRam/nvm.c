@@ -43,6 +43,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "bcm5719_NVM.h"
 
+#include <Lock.h>
 #include <NVRam.h>
 
 #define ATMEL_AT45DB0X1B_PAGE_POS (9u)
@@ -55,15 +56,10 @@
 
 #ifdef CXX_SIMULATOR
 #include <arpa/inet.h>
-#define REQ ReqSet2
-#define CLR ReqClr2
-#define WON ArbWon2
+#include <string.h>
 #else /* Firmware */
 #define ntohl(__x__) (__x__)
 #define htonl(__x__) (__x__)
-#define REQ ReqSet0
-#define CLR ReqClr0
-#define WON ArbWon0
 #endif
 
 /**
@@ -118,27 +114,12 @@ static inline void NVRam_waitDone(void)
 
 bool NVRam_acquireLock(void)
 {
-    // Grab lock
-    RegNVMSoftwareArbitration_t req;
-    req.r32 = 0;
-    req.bits.REQ = 1;
-    NVM.SoftwareArbitration = req;
-
-    while (!NVM.SoftwareArbitration.bits.WON)
-    {
-        // Spin
-    }
-
-    return true;
+    return Lock_acquire(LOCK_NVM, LOCK_TIMEOUT_SPINS);
 }
 
 bool NVRam_releaseLock(void)
 {
-    // Release locks
-    RegNVMSoftwareArbitration_t req;
-    req.r32 = 0;
-    req.bits.CLR = 1;
-    NVM.SoftwareArbitration = req;
+    Lock_release(LOCK_NVM);
 
     return true;
 }
@@ -160,9 +141,169 @@ static uint32_t NVRam_readWordInternal(uint32_t address, RegNVMCommand_t cmd)
 
     return ntohl(NVM.Read.r32);
 }
+static void NVRam_readBurst(uint32_t address, uint32_t *buffer, size_t words)
+{
+    if (!words)
+    {
+        // No data to read.
+        return;
+    }
+
+    // First word.
+    RegNVMCommand_t cmd;
+    cmd.r32 = 0;
+    cmd.bits.Doit = 1;
+    cmd.bits.First = 1;
+
+    while (words)
+    {
+        if (1 == words)
+        {
+            // Last word.
+            cmd.bits.Last = 1;
+        }
+
+        *buffer = NVRam_readWordInternal(address, cmd);
+        buffer++;
+        words--;
+        address += 4;
+
+        // If we have more than one word, clear the first bit.
+        cmd.bits.First = 0;
+    }
+}
+
+#ifdef CXX_SIMULATOR
+/** @brief Number of flash pages held by the host NVRAM cache. */
+#define NVRAM_CACHE_PAGES       (128u)
+
+/** @brief Pages read ahead when misses are sequential. */
+#define NVRAM_CACHE_READ_AHEAD  (4u)
+
+#define PAGE_WORDS              (PAGE_SIZE / 4)
+
+typedef struct
+{
+    uint32_t page;
+    bool valid;
+    uint32_t words[PAGE_WORDS];
+} NVRamCacheBlock_t;
+
+static struct
+{
+    bool enabled;
+    uint32_t lastMiss;
+    NVRamCacheStats_t stats;
+    NVRamCacheBlock_t blocks[NVRAM_CACHE_PAGES];
+} gNVRamCache;
+
+void NVRam_invalidateCache(void)
+{
+    for (size_t i = 0; i < NVRAM_CACHE_PAGES; i++)
+    {
+        gNVRamCache.blocks[i].valid = false;
+    }
+    gNVRamCache.lastMiss = ~0u;
+}
+
+void NVRam_enableCache(bool enable)
+{
+    NVRam_invalidateCache();
+    memset(&gNVRamCache.stats, 0, sizeof(gNVRamCache.stats));
+    gNVRamCache.enabled = enable;
+}
+
+const NVRamCacheStats_t *NVRam_getCacheStats(void)
+{
+    return &gNVRamCache.stats;
+}
+
+static inline void NVRam_cacheInvalidatePage(uint32_t address)
+{
+    uint32_t page = address / PAGE_SIZE;
+    NVRamCacheBlock_t *block = &gNVRamCache.blocks[page % NVRAM_CACHE_PAGES];
+
+    if (block->valid && block->page == page)
+    {
+        block->valid = false;
+    }
+}
+
+/**
+ * @fn  static NVRamCacheBlock_t *NVRam_cachePage(uint32_t page)
+ *
+ * @brief Returns the cache block for @p page, reading it from flash if needed.
+ */
+static NVRamCacheBlock_t *NVRam_cachePage(uint32_t page)
+{
+    NVRamCacheBlock_t *block = &gNVRamCache.blocks[page % NVRAM_CACHE_PAGES];
+
+    if (block->valid && block->page == page)
+    {
+        gNVRamCache.stats.hits++;
+        return block;
+    }
+
+    gNVRamCache.stats.misses++;
+
+    // Sequential misses pull in the following pages with the same burst.
+    uint32_t count = 1;
+    if (page == gNVRamCache.lastMiss + 1)
+    {
+        count += NVRAM_CACHE_READ_AHEAD;
+    }
+
+    // Don't read ahead past the last page of the flash.
+    uint32_t lastPage = (NVRAM_SIZE - 1) / PAGE_SIZE;
+    if (page + count - 1 > lastPage)
+    {
+        count = (page < lastPage) ? lastPage - page + 1 : 1;
+    }
+
+    uint32_t words[PAGE_WORDS * (1 + NVRAM_CACHE_READ_AHEAD)];
+    NVRam_readBurst(page * PAGE_SIZE, words, count * PAGE_WORDS);
+    gNVRamCache.stats.pagesRead += count;
+    gNVRamCache.lastMiss = page + count - 1;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        NVRamCacheBlock_t *fill = &gNVRamCache.blocks[(page + i) % NVRAM_CACHE_PAGES];
+        fill->page = page + i;
+        fill->valid = true;
+        memcpy(fill->words, &words[i * PAGE_WORDS], sizeof(fill->words));
+    }
+
+    return block;
+}
+
+static void NVRam_readCached(uint32_t address, uint32_t *buffer, size_t words)
+{
+    while (words)
+    {
+        NVRamCacheBlock_t *block = NVRam_cachePage(address / PAGE_SIZE);
+        uint32_t offset = (address % PAGE_SIZE) / 4;
+        size_t count = PAGE_WORDS - offset;
+        if (count > words)
+        {
+            count = words;
+        }
+
+        memcpy(buffer, &block->words[offset], count * 4);
+        buffer += count;
+        words -= count;
+        address += count * 4;
+    }
+}
+#endif /* CXX_SIMULATOR */
+
 static void NVRam_writeWordInternal(uint32_t address, uint32_t data,
                                     RegNVMCommand_t cmd)
 {
+#ifdef CXX_SIMULATOR
+    // Write-through: drop the cached copy of the page being programmed.
+    NVRam_cacheInvalidatePage(address);
+#endif
+
     address = NVRam_translate(address);
 
     // Clear the done bit
@@ -180,6 +321,15 @@ static void NVRam_writeWordInternal(uint32_t address, uint32_t data,
 
 uint32_t NVRam_readWord(uint32_t address)
 {
+#ifdef CXX_SIMULATOR
+    if (gNVRamCache.enabled)
+    {
+        uint32_t data;
+        NVRam_readCached(address, &data, 1);
+        return data;
+    }
+#endif
+
     RegNVMCommand_t cmd;
     cmd.r32 = 0;
     cmd.bits.First = 1;
@@ -191,34 +341,60 @@ uint32_t NVRam_readWord(uint32_t address)
 
 void NVRam_read(uint32_t address, uint32_t *buffer, size_t words)
 {
-    if (!words)
+#ifdef CXX_SIMULATOR
+    if (gNVRamCache.enabled)
     {
-        // No data to read.
+        NVRam_readCached(address, buffer, words);
         return;
     }
+#endif
 
-    // First word.
-    RegNVMCommand_t cmd;
-    cmd.r32 = 0;
-    cmd.bits.Doit = 1;
-    cmd.bits.First = 1;
+    NVRam_readBurst(address, buffer, words);
+}
+
+bool NVRam_readStream(uint32_t address, size_t words, uint32_t *buffer,
+                      size_t bufferWords, size_t chunkWords,
+                      NVRamReadCallback_t callback, void *context)
+{
+    size_t ringOffset = 0;
+
+    if (!chunkWords || chunkWords > bufferWords || bufferWords % chunkWords)
+    {
+        return false;
+    }
 
     while (words)
     {
-        if (1 == words)
+        size_t count = (chunkWords < words) ? chunkWords : words;
+        uint32_t *chunk = &buffer[ringOffset];
+
+        // Each chunk is its own First/Last burst so a callback may stop early.
+        NVRam_read(address, chunk, count);
+
+        if (callback && !callback(address, chunk, count, context))
         {
-            // Last word.
-            cmd.bits.Last = 1;
+            return false;
         }
 
-        *buffer = NVRam_readWordInternal(address, cmd);
-        buffer++;
-        words--;
-        address += 4;
-
-        // If we have more than one word, clear the first bit.
-        cmd.bits.First = 0;
+        address += count * 4;
+        words -= count;
+        ringOffset += count;
+        if (ringOffset >= bufferWords)
+        {
+            ringOffset = 0;
+        }
     }
+
+    return true;
+}
+
+bool NVRam_crcCallback(uint32_t address, uint32_t *words, size_t count,
+                       void *context)
+{
+    uint32_t *crc = (uint32_t *)context;
+    *crc = NVRam_crc((const uint8_t *)words, count * 4, *crc);
+
+    return true;
 }
 
 void NVRam_writeWord(uint32_t address, uint32_t data)
@@ -238,30 +414,51 @@ void NVRam_writeWord(uint32_t address, uint32_t data)
     }
 }
 
-void NVRam_write(uint32_t address, uint32_t *buffer, size_t words)
+/**
+ * @fn  static bool NVRam_pageMatches(uint32_t address, const uint32_t *buffer, size_t words)
+ *
+ * @brief Burst reads the given span of a single flash page and compares it.
+ */
+static bool NVRam_pageMatches(uint32_t address, const uint32_t *buffer,
+                              size_t words)
 {
-#if 0
-    if (!words)
-    {
-        // No bytes to read.
-        return;
-    }
+    bool matches = true;
+
+    RegNVMCommand_t cmd;
+    cmd.r32 = 0;
+    cmd.bits.Doit = 1;
+    cmd.bits.First = 1;
 
-    // Reduce beginning of buffer until we find the first different work.
-    while(buffer[0] == NVRam_readWord(address))
+    while (words)
     {
-        address += 4;
+        if (1 == words)
+        {
+            cmd.bits.Last = 1;
+        }
+
+        // Always finish the burst so the page is left with Last set.
+        if (*buffer != NVRam_readWordInternal(address, cmd))
+        {
+            matches = false;
+        }
+
         buffer++;
         words--;
+        address += 4;
+        cmd.bits.First = 0;
     }
 
-    // Trim words at end of buffer if they don't need to change.s
-    while(words && (buffer[words-1] == NVRam_readWord(address + (words-1)*4)))
-    {
-        words--;
-    }
+    return matches;
+}
 
-    // First word.
+/**
+ * @fn  static void NVRam_writePage(uint32_t address, const uint32_t *buffer, size_t words)
+ *
+ * @brief Programs the given span of a single flash page as one burst.
+ */
+static void NVRam_writePage(uint32_t address, const uint32_t *buffer,
+                            size_t words)
+{
     RegNVMCommand_t cmd;
     cmd.r32 = 0;
     cmd.bits.Doit = 1;
@@ -272,7 +469,7 @@ void NVRam_write(uint32_t address, uint32_t *buffer, size_t words)
     {
         if (1 == words)
         {
-            // Last word.
+            // Page boundary or end of data, program the page.
             cmd.bits.Last = 1;
         }
 
@@ -280,17 +477,98 @@ void NVRam_write(uint32_t address, uint32_t *buffer, size_t words)
         buffer++;
         words--;
         address += 4;
-
-        // If we have more than one word, clear the first bit.
         cmd.bits.First = 0;
     }
-#else
+}
+
+/**
+ * @fn  static size_t NVRam_pageWords(uint32_t address, size_t words)
+ *
+ * @brief Returns the number of words up to the end of the page or data.
+ */
+static inline size_t NVRam_pageWords(uint32_t address, size_t words)
+{
+    size_t pageWords = (PAGE_SIZE - (address % PAGE_SIZE)) / 4;
+
+    return (pageWords > words) ? words : pageWords;
+}
+
+size_t NVRam_writePages(uint32_t address, const uint32_t *buffer, size_t words,
+                        NVRamPageStatus_t *status)
+{
+    size_t written = 0;
+
     while (words)
     {
-        NVRam_writeWord(address, *buffer);
-        buffer++;
-        words--;
-        address += 4;
+        size_t pageWords = NVRam_pageWords(address, words);
+        NVRamPageStatus_t pageStatus = NVRAM_PAGE_UNCHANGED;
+
+        if (!NVRam_pageMatches(address, buffer, pageWords))
+        {
+            NVRam_writePage(address, buffer, pageWords);
+            pageStatus = NVRAM_PAGE_WRITTEN;
+            written++;
+        }
+
+        if (status)
+        {
+            *status++ = pageStatus;
+        }
+
+        buffer += pageWords;
+        words -= pageWords;
+        address += pageWords * 4;
     }
-#endif
+
+    return written;
+}
+
+size_t NVRam_writeChanged(uint32_t address, const uint32_t *before,
+                          const uint32_t *buffer, size_t words,
+                          NVRamPageStatus_t *status)
+{
+    size_t written = 0;
+
+    while (words)
+    {
+        size_t pageWords = NVRam_pageWords(address, words);
+        NVRamPageStatus_t pageStatus = NVRAM_PAGE_UNCHANGED;
+
+        for (size_t i = 0; i < pageWords; i++)
+        {
+            if (before[i] != buffer[i])
+            {
+                pageStatus = NVRAM_PAGE_WRITTEN;
+                break;
+            }
+        }
+
+        if (NVRAM_PAGE_WRITTEN == pageStatus)
+        {
+            NVRam_writePage(address, buffer, pageWords);
+            written++;
+
+            if (!NVRam_pageMatches(address, buffer, pageWords))
+            {
+                pageStatus = NVRAM_PAGE_VERIFY_FAILED;
+            }
+        }
+
+        if (status)
+        {
+            *status++ = pageStatus;
+        }
+
+        before += pageWords;
+        buffer += pageWords;
+        words -= pageWords;
+        address += pageWords * 4;
+    }
+
+    return written;
+}
+
+void NVRam_write(uint32_t address, uint32_t *buffer, size_t words)
+{
+    (void)NVRam_writePages(address, buffer, words, NULL);
 }
@@ -0,0 +1,41 @@
+#include "gtest/gtest.h"
+#include <NVRam.h>
+
+namespace {
+
+static uint32_t crc_bitwise(const uint8_t *data, uint32_t length, uint32_t crc)
+{
+    while (length--)
+    {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+        }
+    }
+    return crc;
+}
+
+TEST(NVRam, CRCMatchesBitwise) {
+    static uint8_t data[4096 + 8];
+    for (unsigned int i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (i * 2654435761u) >> 13;
+    }
+
+    // Cover the unaligned head, the wide paths and the byte-wise tail.
+    const uint32_t lengths[] = { 0, 1, 7, 8, 15, 63, 64, 65, 127, 1000, 4096 };
+    for (uint32_t offset = 0; offset < 8; offset++)
+    {
+        for (uint32_t length : lengths)
+        {
+            uint32_t expected = crc_bitwise(data + offset, length, 0xffffffff);
+            EXPECT_EQ(NVRam_crc(data + offset, length, 0xffffffff), expected);
+            EXPECT_EQ(NVRam_crcSoftware(data + offset, length, 0xffffffff), expected);
+        }
+    }
+
+    EXPECT_EQ(~NVRam_crc((const uint8_t *)"123456789", 9, 0xffffffff), 0xCBF43926u);
+}
+
+}  // namespace
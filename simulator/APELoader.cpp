@@ -0,0 +1,327 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       APELoader.cpp
+///
+/// @project    
+///
+/// @brief      Host side interface to the APE loader mailbox
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#include <APELoader.h>
+#include <bcm5719_SHM.h>
+#include <types.h>
+#include <ape_loader_ring.h>
+#include <Compress.h>
+
+#include <stddef.h>
+#include <string.h>
+
+#define LOADER_BUFFER_WORDS ARRAY_ELEMENTS(SHM.LoaderBuffer)
+
+// Input chunk size for DECOMPRESS. Each chunk is compressed on its own and
+// must fit in the staging buffer, typical code compresses about 2:1.
+#define COMPRESS_CHUNK_WORDS (LOADER_BUFFER_WORDS * 2)
+
+#define RING_FIELD(__field__) \
+    (gRingOffset + offsetof(APELoaderRing_t, __field__))
+#define RING_ENTRY_FIELD(__index__, __field__) \
+    (RING_FIELD(entry) + (__index__) * sizeof(APELoaderRingEntry_t) + offsetof(APELoaderRingEntry_t, __field__))
+
+static bool gRingValid;
+static uint32_t gRingOffset;
+static uint32_t gProducer;
+static uint32_t gConsumer;
+
+// Destination of each outstanding READ_MEM in the ring.
+static uint32_t *gPendingReads[APE_LOADER_RING_ENTRIES];
+
+static inline uint32_t ring_next(uint32_t index)
+{
+    return (index + 1 == APE_LOADER_RING_ENTRIES) ? 0 : index + 1;
+}
+
+static void ring_collect(void)
+{
+    uint32_t consumer = SHM.read(RING_FIELD(consumer));
+
+    while (gConsumer != consumer)
+    {
+        if (gPendingReads[gConsumer])
+        {
+            *gPendingReads[gConsumer] = SHM.read(RING_ENTRY_FIELD(gConsumer, result));
+            gPendingReads[gConsumer] = NULL;
+        }
+
+        gConsumer = ring_next(gConsumer);
+    }
+}
+
+static void ring_queue(uint32_t command, uint32_t arg0, uint32_t arg1, uint32_t *result)
+{
+    uint32_t next = ring_next(gProducer);
+    while (next == gConsumer)
+    {
+        // Ring is full, wait for the loader to catch up.
+        ring_collect();
+    }
+
+    SHM.write(RING_ENTRY_FIELD(gProducer, command), command);
+    SHM.write(RING_ENTRY_FIELD(gProducer, arg0), arg0);
+    SHM.write(RING_ENTRY_FIELD(gProducer, arg1), arg1);
+    gPendingReads[gProducer] = result;
+
+    gProducer = next;
+    SHM.write(RING_FIELD(producer), gProducer);
+}
+
+static void loader_command(uint32_t command, uint32_t arg0, uint32_t arg1)
+{
+    // Mailbox commands must not overtake anything still in the ring.
+    APELoader_flush();
+
+    SHM.LoaderArg0.r32 = arg0;
+    SHM.LoaderArg1.r32 = arg1;
+    SHM.LoaderCommand.bits.Command = command;
+
+    // Wait for command to be handled.
+    while(0 != SHM.LoaderCommand.bits.Command);
+}
+
+uint32_t APELoader_readWord(uint32_t addr)
+{
+    loader_command(SHM_LOADER_COMMAND_COMMAND_READ_MEM, addr, 0);
+
+    return (uint32_t)SHM.LoaderArg0.r32;
+}
+
+void APELoader_writeWord(uint32_t addr, uint32_t value)
+{
+    loader_command(SHM_LOADER_COMMAND_COMMAND_WRITE_MEM, addr, value);
+}
+
+uint32_t APELoader_readCallback(uint32_t val, uint32_t offset, void *args)
+{
+    uint32_t addr = (uint32_t)((uint64_t)args);
+
+    return APELoader_readWord(addr + offset);
+}
+
+uint32_t APELoader_writeCallback(uint32_t val, uint32_t offset, void *args)
+{
+    uint32_t addr = (uint32_t)((uint64_t)args);
+
+    // Reads and every other loader command flush the ring first.
+    APELoader_queueWrite(addr + offset, val);
+    return val;
+}
+
+uint32_t APELoader_crc(uint32_t addr, uint32_t bytes)
+{
+    loader_command(SHM_LOADER_COMMAND_COMMAND_CRC, addr, bytes);
+
+    return (uint32_t)SHM.LoaderArg0.r32;
+}
+
+void APELoader_readMem(uint32_t addr, uint32_t *words, size_t count)
+{
+    while (count)
+    {
+        size_t chunk = count < LOADER_BUFFER_WORDS ? count : LOADER_BUFFER_WORDS;
+
+        loader_command(SHM_LOADER_COMMAND_COMMAND_READ_BLOCK, addr, chunk * 4);
+        for (size_t i = 0; i < chunk; i++)
+        {
+            words[i] = SHM.LoaderBuffer[i].r32;
+        }
+
+        addr += chunk * 4;
+        words += chunk;
+        count -= chunk;
+    }
+}
+
+void APELoader_writeMem(uint32_t addr, const uint32_t *words, size_t count)
+{
+    while (count)
+    {
+        size_t chunk = count < LOADER_BUFFER_WORDS ? count : LOADER_BUFFER_WORDS;
+
+        for (size_t i = 0; i < chunk; i++)
+        {
+            SHM.LoaderBuffer[i].r32 = words[i];
+        }
+        loader_command(SHM_LOADER_COMMAND_COMMAND_WRITE_BLOCK, addr, chunk * 4);
+
+        addr += chunk * 4;
+        words += chunk;
+        count -= chunk;
+    }
+}
+
+void APELoader_memset(uint32_t addr, uint32_t value, size_t count)
+{
+    if (count)
+    {
+        SHM.LoaderBuffer[0].r32 = value;
+        loader_command(SHM_LOADER_COMMAND_COMMAND_MEMSET, addr, count * 4);
+    }
+}
+
+static bool is_zero(const uint32_t *words, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (words[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool upload_compressed(uint32_t addr, const uint32_t *words, size_t bytes, size_t *sent)
+{
+    uint8_t compressed[COMPRESS_CHUNK_WORDS * 4 * 2];
+    int32_t compressedBytes = compress(compressed, sizeof(compressed), (const uint8_t *)words, bytes);
+    if (compressedBytes <= 0 || (size_t)compressedBytes > LOADER_BUFFER_WORDS * 4)
+    {
+        // Does not fit in the staging buffer.
+        return false;
+    }
+
+    size_t compressedWords = (compressedBytes + 3) / 4;
+    memset(&compressed[compressedBytes], 0, compressedWords * 4 - compressedBytes);
+    for (size_t i = 0; i < compressedWords; i++)
+    {
+        SHM.LoaderBuffer[i].r32 = ((uint32_t *)compressed)[i];
+    }
+    *sent += compressedWords * 4;
+
+    loader_command(SHM_LOADER_COMMAND_COMMAND_DECOMPRESS, addr, (bytes << 16) | compressedBytes);
+
+    // The loader returns the number of bytes it produced.
+    return bytes == SHM.LoaderArg0.r32;
+}
+
+size_t APELoader_writeCompressed(uint32_t addr, const uint32_t *words, size_t count)
+{
+    size_t sent = 0;
+
+    while (count)
+    {
+        size_t chunk = count < COMPRESS_CHUNK_WORDS ? count : COMPRESS_CHUNK_WORDS;
+        size_t bytes = chunk * 4;
+
+        if (is_zero(words, chunk))
+        {
+            APELoader_memset(addr, 0, chunk);
+            sent += 4;
+        }
+        else if (!upload_compressed(addr, words, bytes, &sent))
+        {
+            // Incompressible, or not fully expanded by the loader.
+            APELoader_writeMem(addr, words, chunk);
+            sent += bytes;
+        }
+
+        addr += bytes;
+        words += chunk;
+        count -= chunk;
+    }
+
+    return sent;
+}
+
+bool APELoader_initRing(void)
+{
+    gRingValid = false;
+
+    uint32_t offset = SHM.SegMessageBufferOffset.r32;
+    uint32_t length = SHM.SegMessageBufferLength.r32;
+    if (SHM_SEG_SIG_SIG_LOADER != SHM.SegSig.bits.Sig || !offset || length < sizeof(APELoaderRing_t))
+    {
+        return false;
+    }
+
+    gRingOffset = offset;
+    if (APE_LOADER_RING_ENTRIES != SHM.read(RING_FIELD(entries)))
+    {
+        return false;
+    }
+
+    // Resynchronize with the loader, nothing is outstanding.
+    gConsumer = SHM.read(RING_FIELD(consumer));
+    gProducer = gConsumer;
+    SHM.write(RING_FIELD(producer), gProducer);
+    memset(gPendingReads, 0, sizeof(gPendingReads));
+
+    gRingValid = true;
+    return true;
+}
+
+void APELoader_queueWrite(uint32_t addr, uint32_t value)
+{
+    if (gRingValid)
+    {
+        ring_queue(SHM_LOADER_COMMAND_COMMAND_WRITE_MEM, addr, value, NULL);
+    }
+    else
+    {
+        APELoader_writeWord(addr, value);
+    }
+}
+
+void APELoader_queueRead(uint32_t addr, uint32_t *value)
+{
+    if (gRingValid)
+    {
+        ring_queue(SHM_LOADER_COMMAND_COMMAND_READ_MEM, addr, 0, value);
+    }
+    else
+    {
+        *value = APELoader_readWord(addr);
+    }
+}
+
+void APELoader_flush(void)
+{
+    while (gRingValid && gConsumer != gProducer)
+    {
+        ring_collect();
+    }
+}
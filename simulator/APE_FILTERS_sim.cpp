@@ -44,80 +44,51 @@
 
 #include <stdint.h>
 #include <utility>
-#include <bcm5719_SHM.h>
+#include <APELoader.h>
 #include <APE_FILTERS.h>
 
-static uint32_t loader_read_mem(uint32_t val, uint32_t offset, void *args)
-{
-    uint32_t addr = (uint32_t)((uint64_t)args);
-    addr += offset;
-
-    SHM.LoaderArg0.r32 = addr;
-    SHM.LoaderCommand.bits.Command = SHM_LOADER_COMMAND_COMMAND_READ_MEM;
-
-    // Wait for command to be handled.
-    while(0 != SHM.LoaderCommand.bits.Command);
-
-    return (uint32_t)SHM.LoaderArg0.r32;
-}
-
-static uint32_t loader_write_mem(uint32_t val, uint32_t offset, void *args)
-{
-    uint32_t addr = (uint32_t)((uint64_t)args);
-    addr += offset;
-
-    SHM.LoaderArg0.r32 = addr;
-    SHM.LoaderArg1.r32 = val;
-    SHM.LoaderCommand.bits.Command = SHM_LOADER_COMMAND_COMMAND_WRITE_MEM;
-
-    // Wait for command to be handled.
-    while(0 != SHM.LoaderCommand.bits.Command);
-
-    return val;
-}
-
 void init_APE_FILTERS_sim(void *arg0)
 {
     (void)arg0; // unused
     void* base = (void*)0xa0048000;
 
-    FILTERS.mIndexReadCallback = loader_read_mem;
+    FILTERS.mIndexReadCallback = APELoader_readCallback;
     FILTERS.mIndexReadCallbackArgs = base;
 
-    FILTERS.mIndexWriteCallback = loader_write_mem;
+    FILTERS.mIndexWriteCallback = APELoader_writeCallback;
     FILTERS.mIndexWriteCallbackArgs = base;
 
     /** @brief Component Registers for @ref FILTERS. */
     /** @brief Bitmap for @ref FILTERS_t.ElementConfig. */
     for(int i = 0; i < 32; i++)
     {
-        FILTERS.ElementConfig[i].r32.installReadCallback(loader_read_mem, (uint8_t *)base);
-        FILTERS.ElementConfig[i].r32.installWriteCallback(loader_write_mem, (uint8_t *)base);
+        FILTERS.ElementConfig[i].r32.installReadCallback(APELoader_readCallback, (uint8_t *)base);
+        FILTERS.ElementConfig[i].r32.installWriteCallback(APELoader_writeCallback, (uint8_t *)base);
     }
 
     /** @brief Bitmap for @ref FILTERS_t.ElementPattern. */
     for(int i = 0; i < 32; i++)
     {
-        FILTERS.ElementPattern[i].r32.installReadCallback(loader_read_mem, (uint8_t *)base);
-        FILTERS.ElementPattern[i].r32.installWriteCallback(loader_write_mem, (uint8_t *)base);
+        FILTERS.ElementPattern[i].r32.installReadCallback(APELoader_readCallback, (uint8_t *)base);
+        FILTERS.ElementPattern[i].r32.installWriteCallback(APELoader_writeCallback, (uint8_t *)base);
     }
 
     /** @brief Bitmap for @ref FILTERS_t.RuleConfiguration. */
-    FILTERS.RuleConfiguration.r32.installReadCallback(loader_read_mem, (uint8_t *)base);
-    FILTERS.RuleConfiguration.r32.installWriteCallback(loader_write_mem, (uint8_t *)base);
+    FILTERS.RuleConfiguration.r32.installReadCallback(APELoader_readCallback, (uint8_t *)base);
+    FILTERS.RuleConfiguration.r32.installWriteCallback(APELoader_writeCallback, (uint8_t *)base);
 
     /** @brief Bitmap for @ref FILTERS_t.RuleSet. */
     for(int i = 0; i < 31; i++)
     {
-        FILTERS.RuleSet[i].r32.installReadCallback(loader_read_mem, (uint8_t *)base);
-        FILTERS.RuleSet[i].r32.installWriteCallback(loader_write_mem, (uint8_t *)base);
+        FILTERS.RuleSet[i].r32.installReadCallback(APELoader_readCallback, (uint8_t *)base);
+        FILTERS.RuleSet[i].r32.installWriteCallback(APELoader_writeCallback, (uint8_t *)base);
     }
 
     /** @brief Bitmap for @ref FILTERS_t.RuleMask. */
     for(int i = 0; i < 31; i++)
     {
-        FILTERS.RuleMask[i].r32.installReadCallback(loader_read_mem, (uint8_t *)base);
-        FILTERS.RuleMask[i].r32.installWriteCallback(loader_write_mem, (uint8_t *)base);
+        FILTERS.RuleMask[i].r32.installReadCallback(APELoader_readCallback, (uint8_t *)base);
+        FILTERS.RuleMask[i].r32.installWriteCallback(APELoader_writeCallback, (uint8_t *)base);
     }
 
 
@@ -44,55 +44,26 @@
 
 #include <stdint.h>
 #include <utility>
-#include <bcm5719_SHM.h>
+#include <APELoader.h>
 #include <APE_TX_PORT1.h>
 
-static uint32_t loader_read_mem(uint32_t val, uint32_t offset, void *args)
-{
-    uint32_t addr = (uint32_t)((uint64_t)args);
-    addr += offset;
-
-    SHM.LoaderArg0.r32 = addr;
-    SHM.LoaderCommand.bits.Command = SHM_LOADER_COMMAND_COMMAND_READ_MEM;
-
-    // Wait for command to be handled.
-    while(0 != SHM.LoaderCommand.bits.Command);
-
-    return (uint32_t)SHM.LoaderArg0.r32;
-}
-
-static uint32_t loader_write_mem(uint32_t val, uint32_t offset, void *args)
-{
-    uint32_t addr = (uint32_t)((uint64_t)args);
-    addr += offset;
-
-    SHM.LoaderArg0.r32 = addr;
-    SHM.LoaderArg1.r32 = val;
-    SHM.LoaderCommand.bits.Command = SHM_LOADER_COMMAND_COMMAND_WRITE_MEM;
-
-    // Wait for command to be handled.
-    while(0 != SHM.LoaderCommand.bits.Command);
-
-    return val;
-}
-
 void init_APE_TX_PORT1_sim(void *arg0)
 {
     (void)arg0; // unused
     void* base = (void*)0xa0022000;
 
-    TX_PORT1.mIndexReadCallback = loader_read_mem;
+    TX_PORT1.mIndexReadCallback = APELoader_readCallback;
     TX_PORT1.mIndexReadCallbackArgs = base;
 
-    TX_PORT1.mIndexWriteCallback = loader_write_mem;
+    TX_PORT1.mIndexWriteCallback = APELoader_writeCallback;
     TX_PORT1.mIndexWriteCallbackArgs = base;
 
     /** @brief Component Registers for @ref TX_PORT1. */
     /** @brief Bitmap for @ref TX_PORT1_t.Out. */
     for(int i = 0; i < 2048; i++)
     {
-        TX_PORT1.Out[i].r32.installReadCallback(loader_read_mem, (uint8_t *)base);
-        TX_PORT1.Out[i].r32.installWriteCallback(loader_write_mem, (uint8_t *)base);
+        TX_PORT1.Out[i].r32.installReadCallback(APELoader_readCallback, (uint8_t *)base);
+        TX_PORT1.Out[i].r32.installWriteCallback(APELoader_writeCallback, (uint8_t *)base);
     }
 
 
@@ -0,0 +1,548 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       DeviceModel.cpp
+///
+/// @project    
+///
+/// @brief      Software model of the BCM5719 register interface
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#include <DeviceModel.h>
+#include <CXXRegister.h>
+
+#include "../libs/NVRam/bcm5719_NVM.h"
+#include <bcm5719_APE.h>
+#include <bcm5719_APE_PERI.h>
+#include <bcm5719_DEVICE.h>
+#include <bcm5719_SHM.h>
+#include <types.h>
+#include <ape_loader_ring.h>
+#include <Compress.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+#define NUM_BARS            4
+#define DEFAULT_NVRAM_SIZE  (256 * 1024)
+#define NVRAM_PAGE_SIZE     264
+#define NUM_PHYS            32
+#define NUM_PHY_REGS        32
+#define MII_CONTROL_REGISTER 0
+#define MII_CONTROL_RESET    0x8000u
+
+#define MODEL_CHIP_ID           0x05719001
+#define MODEL_VENDOR_DEVICE_ID  0x14e41657
+
+/** @brief NVM arbitration request bits, not described in the register map. */
+#define NVM_SOFTWARE_ARBITRATION_REQ_SHIFT 12u
+
+typedef uint32_t (*model_handler_t)(unsigned int index, uint32_t value);
+
+typedef struct
+{
+    model_handler_t handler;
+    unsigned int index;
+} model_register_t;
+
+typedef struct
+{
+    uint8_t *bars[NUM_BARS];
+
+    uint8_t *nvram;
+    size_t nvramSize;
+
+    uint16_t phy[NUM_PHYS][NUM_PHY_REGS];
+
+    // Sparse APE address space used by the loader mailbox.
+    unordered_map<uint32_t, uint32_t> apeMemory;
+
+    // Handlers for stateful registers, by MMIO address.
+    unordered_map<uintptr_t, model_register_t> registers;
+
+    volatile uint32_t *perLockRequest[8];
+    volatile uint32_t *perLockGrant[8];
+} model_state_t;
+
+static model_state_t *gModel;
+
+static volatile uint32_t &reg32(CXXRegisterBase &reg)
+{
+    return *(volatile uint32_t *)reg.getMMIOAddress();
+}
+
+static void add_handler(volatile void *addr, model_handler_t handler, unsigned int index = 0)
+{
+    model_register_t entry = { handler, index };
+    gModel->registers[(uintptr_t)addr] = entry;
+}
+
+static void add_handler(CXXRegisterBase &reg, model_handler_t handler, unsigned int index = 0)
+{
+    add_handler(reg.getMMIOAddress(), handler, index);
+}
+
+static volatile APELoaderRing_t *loader_ring(void)
+{
+    return (volatile APELoaderRing_t *)((uint8_t *)SHM.SegSig.r32.getMMIOAddress() + APE_LOADER_RING_OFFSET);
+}
+
+static uint32_t nvm_command(unsigned int index, uint32_t cmd)
+{
+    uint32_t status = reg32(NVM.Command.r32) & NVM_COMMAND_DONE_MASK;
+
+    if (cmd & NVM_COMMAND_DONE_MASK)
+    {
+        // Write 1 to clear.
+        status = 0;
+    }
+
+    if (cmd & NVM_COMMAND_DOIT_MASK)
+    {
+        uint32_t addr = (reg32(NVM.Addr.r32) & 0xFFFFFF) % gModel->nvramSize;
+        uint8_t *data = &gModel->nvram[addr & ~3u];
+
+        if (!(cmd & NVM_COMMAND_WR_MASK))
+        {
+            reg32(NVM.Read.r32) = (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+        }
+        else if (reg32(NVM.Access.r32) & NVM_ACCESS_WRITE_ENABLE_MASK)
+        {
+            if (cmd & NVM_COMMAND_ERASE_MASK)
+            {
+                size_t page = addr - (addr % NVRAM_PAGE_SIZE);
+                size_t length = NVRAM_PAGE_SIZE;
+                if (page + length > gModel->nvramSize)
+                {
+                    length = gModel->nvramSize - page;
+                }
+                memset(&gModel->nvram[page], 0xFF, length);
+            }
+            else
+            {
+                uint32_t word = reg32(NVM.Write.r32);
+                data[0] = word >> 24;
+                data[1] = word >> 16;
+                data[2] = word >> 8;
+                data[3] = word;
+            }
+        }
+
+        status = NVM_COMMAND_DONE_MASK;
+    }
+
+    return status;
+}
+
+static uint32_t nvm_arbitration(unsigned int index, uint32_t value)
+{
+    uint32_t state = reg32(NVM.SoftwareArbitration.r32);
+    uint32_t requests = (state >> NVM_SOFTWARE_ARBITRATION_REQ_SHIFT) & 0xF;
+    uint32_t won = (state & 0xF00) >> 8;
+
+    requests |= value & 0xF;
+    requests &= ~((value >> 4) & 0xF);
+    won &= requests;
+
+    if (!won && requests)
+    {
+        // Grant the highest priority (lowest numbered) requester.
+        won = requests & -requests;
+    }
+
+    return (requests << NVM_SOFTWARE_ARBITRATION_REQ_SHIFT) | (won << 8);
+}
+
+static uint32_t mii_communication(unsigned int index, uint32_t value)
+{
+    if (!(value & DEVICE_MII_COMMUNICATION_START_DIV_BUSY_MASK))
+    {
+        return value;
+    }
+
+    uint32_t phy = (value & DEVICE_MII_COMMUNICATION_PHY_ADDRESS_MASK) >> DEVICE_MII_COMMUNICATION_PHY_ADDRESS_SHIFT;
+    uint32_t reg = (value & DEVICE_MII_COMMUNICATION_REGISTER_ADDRESS_MASK) >> DEVICE_MII_COMMUNICATION_REGISTER_ADDRESS_SHIFT;
+    uint32_t command = (value & DEVICE_MII_COMMUNICATION_COMMAND_MASK) >> DEVICE_MII_COMMUNICATION_COMMAND_SHIFT;
+    uint16_t *data = &gModel->phy[phy][reg];
+
+    value &= ~DEVICE_MII_COMMUNICATION_START_DIV_BUSY_MASK;
+    if (DEVICE_MII_COMMUNICATION_COMMAND_WRITE == command)
+    {
+        *data = value & DEVICE_MII_COMMUNICATION_TRANSACTION_DATA_MASK;
+
+        if (MII_CONTROL_REGISTER == reg)
+        {
+            // Resets complete immediately.
+            *data &= ~MII_CONTROL_RESET;
+        }
+    }
+    else
+    {
+        value &= ~DEVICE_MII_COMMUNICATION_TRANSACTION_DATA_MASK;
+        value |= *data;
+    }
+
+    return value;
+}
+
+static uint32_t ape_mode(unsigned int index, uint32_t value)
+{
+    if (value & APE_MODE_RESET_MASK)
+    {
+        // Any image started on the APE is assumed to be the loader.
+        reg32(SHM.SegSig.r32) = SHM_SEG_SIG_SIG_LOADER;
+        reg32(SHM.SegMessageBufferOffset.r32) = APE_LOADER_RING_OFFSET;
+        reg32(SHM.SegMessageBufferLength.r32) = sizeof(APELoaderRing_t);
+        loader_ring()->producer = 0;
+        loader_ring()->consumer = 0;
+        loader_ring()->entries = APE_LOADER_RING_ENTRIES;
+        reg32(SHM.FwStatus.r32) |= SHM_FW_STATUS_READY_MASK;
+        value &= ~APE_MODE_RESET_MASK;
+    }
+
+    return value;
+}
+
+static uint32_t loader_block_words(uint32_t bytes)
+{
+    uint32_t words = bytes / 4;
+    return words < ARRAY_ELEMENTS(SHM.LoaderBuffer) ? words : ARRAY_ELEMENTS(SHM.LoaderBuffer);
+}
+
+static uint32_t loader_execute(uint32_t command, uint32_t arg0, uint32_t arg1)
+{
+    uint32_t result = 0;
+
+    switch (command)
+    {
+        default:
+        case SHM_LOADER_COMMAND_COMMAND_NOP:
+        case SHM_LOADER_COMMAND_COMMAND_CALL:
+            // Calls can not be modeled, treat them as returning immediately.
+            break;
+
+        case SHM_LOADER_COMMAND_COMMAND_READ_MEM:
+            result = gModel->apeMemory[arg0 & ~3u];
+            break;
+
+        case SHM_LOADER_COMMAND_COMMAND_WRITE_MEM:
+            gModel->apeMemory[arg0 & ~3u] = arg1;
+            break;
+
+        case SHM_LOADER_COMMAND_COMMAND_READ_BLOCK:
+            for (uint32_t i = 0; i < loader_block_words(arg1); i++)
+            {
+                reg32(SHM.LoaderBuffer[i].r32) = gModel->apeMemory[(arg0 & ~3u) + i * 4];
+            }
+            break;
+
+        case SHM_LOADER_COMMAND_COMMAND_WRITE_BLOCK:
+            for (uint32_t i = 0; i < loader_block_words(arg1); i++)
+            {
+                gModel->apeMemory[(arg0 & ~3u) + i * 4] = reg32(SHM.LoaderBuffer[i].r32);
+            }
+            break;
+
+        case SHM_LOADER_COMMAND_COMMAND_DECOMPRESS:
+        {
+            vector<uint8_t> out(arg1 >> 16);
+            uint32_t inBytes = arg1 & 0xFFFF;
+            if (inBytes > sizeof(SHM.LoaderBuffer))
+            {
+                inBytes = sizeof(SHM.LoaderBuffer);
+            }
+
+            result = decompress_fast(out.data(), out.size(), (const uint8_t *)SHM.LoaderBuffer[0].r32.getMMIOAddress(), inBytes);
+            for (uint32_t i = 0; i < result; i++)
+            {
+                uint32_t &word = gModel->apeMemory[(arg0 + i) & ~3u];
+                uint32_t shift = ((arg0 + i) & 3u) * 8;
+                word = (word & ~(0xFFu << shift)) | ((uint32_t)out[i] << shift);
+            }
+            break;
+        }
+
+        case SHM_LOADER_COMMAND_COMMAND_CRC:
+            result = 0xFFFFFFFF;
+            for (uint32_t i = 0; i < arg1; i++)
+            {
+                uint32_t addr = arg0 + i;
+                uint8_t data = gModel->apeMemory[addr & ~3u] >> ((addr & 3u) * 8);
+                for (int bit = 0; bit < 8; bit++, data >>= 1)
+                {
+                    // Same polynomial and bit order as NVRam_crc.
+                    result = (result >> 1) ^ (((result ^ data) & 1) ? 0xEDB88320 : 0);
+                }
+            }
+            break;
+
+        case SHM_LOADER_COMMAND_COMMAND_MEMSET:
+            for (uint32_t i = 0; i < arg1 / 4; i++)
+            {
+                gModel->apeMemory[(arg0 & ~3u) + i * 4] = reg32(SHM.LoaderBuffer[0].r32);
+            }
+            break;
+    }
+
+    return result;
+}
+
+static uint32_t loader_command(unsigned int index, uint32_t command)
+{
+    uint32_t result = loader_execute(command, reg32(SHM.LoaderArg0.r32), reg32(SHM.LoaderArg1.r32));
+    if (SHM_LOADER_COMMAND_COMMAND_READ_MEM == command ||
+        SHM_LOADER_COMMAND_COMMAND_DECOMPRESS == command ||
+        SHM_LOADER_COMMAND_COMMAND_CRC == command)
+    {
+        reg32(SHM.LoaderArg0.r32) = result;
+    }
+
+    // Mark command as handled.
+    return SHM_LOADER_COMMAND_COMMAND_NOP;
+}
+
+static uint32_t loader_ring_producer(unsigned int index, uint32_t producer)
+{
+    volatile APELoaderRing_t *ring = loader_ring();
+    uint32_t consumer = ring->consumer;
+
+    // The model keeps up with the host, drain everything immediately.
+    while (consumer != producer && producer < APE_LOADER_RING_ENTRIES)
+    {
+        volatile APELoaderRingEntry_t *entry = &ring->entry[consumer];
+        entry->result = loader_execute(entry->command, entry->arg0, entry->arg1);
+
+        if (++consumer == APE_LOADER_RING_ENTRIES)
+        {
+            consumer = 0;
+        }
+    }
+    ring->consumer = consumer;
+
+    return producer;
+}
+
+static void update_lock_grant(unsigned int index)
+{
+    volatile uint32_t *request = gModel->perLockRequest[index];
+    volatile uint32_t *grant = gModel->perLockGrant[index];
+
+    if (!*grant && *request)
+    {
+        *grant = *request & -*request;
+    }
+}
+
+static uint32_t per_lock_request(unsigned int index, uint32_t value)
+{
+    value |= *gModel->perLockRequest[index];
+    *gModel->perLockRequest[index] = value;
+    update_lock_grant(index);
+
+    return value;
+}
+
+static uint32_t per_lock_grant(unsigned int index, uint32_t value)
+{
+    // Writing a granted bit releases the lock.
+    *gModel->perLockRequest[index] &= ~value;
+    *gModel->perLockGrant[index] &= ~value;
+    update_lock_grant(index);
+
+    return *gModel->perLockGrant[index];
+}
+
+static uint32_t grc_mutex_request(unsigned int index, uint32_t value)
+{
+    volatile uint32_t &grant = reg32(DEVICE.MutexGrant.r32);
+    if (!grant && value)
+    {
+        grant = value & -value;
+    }
+
+    return value;
+}
+
+static uint32_t grc_mutex_grant(unsigned int index, uint32_t value)
+{
+    // Writing the granted bit releases the mutex.
+    volatile uint32_t &request = reg32(DEVICE.MutexRequest.r32);
+    uint32_t grant = reg32(DEVICE.MutexGrant.r32) & ~value;
+
+    request &= ~value;
+    if (!grant && request)
+    {
+        grant = request & -request;
+    }
+
+    return grant;
+}
+
+bool DeviceModel_init(const char *nvram_path)
+{
+    if (gModel)
+    {
+        return false;
+    }
+
+    model_state_t *model = new model_state_t();
+    model->nvramSize = DEFAULT_NVRAM_SIZE;
+
+    FILE *file = NULL;
+    if (nvram_path && *nvram_path)
+    {
+        file = fopen(nvram_path, "rb");
+        if (!file)
+        {
+            fprintf(stderr, "Unable to open NVRAM image %s\n", nvram_path);
+            delete model;
+            return false;
+        }
+
+        fseek(file, 0, SEEK_END);
+        long length = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (length > (long)model->nvramSize)
+        {
+            model->nvramSize = length;
+        }
+    }
+
+    model->nvram = (uint8_t *)malloc(model->nvramSize);
+    memset(model->nvram, 0xFF, model->nvramSize);
+    if (file)
+    {
+        size_t read = fread(model->nvram, 1, model->nvramSize, file);
+        fclose(file);
+        printf("Loaded %zu byte NVRAM image from %s\n", read, nvram_path);
+    }
+
+    for (unsigned int i = 0; i < NUM_BARS; i++)
+    {
+        model->bars[i] = (uint8_t *)calloc(1, DEVICE_MODEL_BAR_SIZE);
+    }
+
+    gModel = model;
+    return true;
+}
+
+uint8_t *DeviceModel_getBAR(unsigned int bar)
+{
+    if (!gModel || bar >= NUM_BARS)
+    {
+        return NULL;
+    }
+
+    return gModel->bars[bar];
+}
+
+uint8_t *DeviceModel_getNVRAM(size_t *size)
+{
+    if (!gModel)
+    {
+        return NULL;
+    }
+
+    if (size)
+    {
+        *size = gModel->nvramSize;
+    }
+    return gModel->nvram;
+}
+
+void DeviceModel_bind(void)
+{
+    // Reset values.
+    reg32(DEVICE.ChipId.r32) = MODEL_CHIP_ID;
+    reg32(DEVICE.PciVendorDeviceId.r32) = MODEL_VENDOR_DEVICE_ID;
+    reg32(SHM.ChipId.r32) = MODEL_CHIP_ID;
+    reg32(NVM.Command.r32) = NVM_COMMAND_DONE_MASK;
+
+    add_handler(NVM.Command.r32, nvm_command);
+    add_handler(NVM.SoftwareArbitration.r32, nvm_arbitration);
+    add_handler(DEVICE.MiiCommunication.r32, mii_communication);
+    add_handler(DEVICE.MutexRequest.r32, grc_mutex_request);
+    add_handler(DEVICE.MutexGrant.r32, grc_mutex_grant);
+    add_handler(APE.Mode.r32, ape_mode);
+    add_handler(SHM.LoaderCommand.r32, loader_command);
+    add_handler(&loader_ring()->producer, loader_ring_producer);
+
+    CXXRegisterBase *requests[] = {
+        &APE_PERI.PerLockRequestPhy0.r32, &APE_PERI.PerLockRequestGrc.r32,
+        &APE_PERI.PerLockRequestPhy1.r32, &APE_PERI.PerLockRequestPhy2.r32,
+        &APE_PERI.PerLockRequestMem.r32,  &APE_PERI.PerLockRequestPhy3.r32,
+        &APE_PERI.PerLockRequestPort6.r32, &APE_PERI.PerLockRequestGpio.r32,
+    };
+    CXXRegisterBase *grants[] = {
+        &APE_PERI.PerLockGrantPhy0.r32, &APE_PERI.PerLockGrantGrc.r32,
+        &APE_PERI.PerLockGrantPhy1.r32, &APE_PERI.PerLockGrantPhy2.r32,
+        &APE_PERI.PerLockGrantMem.r32,  &APE_PERI.PerLockGrantPhy3.r32,
+        &APE_PERI.PerLockGrantPort6.r32, &APE_PERI.PerLockGrantGpio.r32,
+    };
+    for (unsigned int i = 0; i < sizeof(requests) / sizeof(requests[0]); i++)
+    {
+        gModel->perLockRequest[i] = &reg32(*requests[i]);
+        gModel->perLockGrant[i] = &reg32(*grants[i]);
+        add_handler(*requests[i], per_lock_request, i);
+        add_handler(*grants[i], per_lock_grant, i);
+    }
+
+    CXXRegisterBase::mmioBackend() = DeviceModel_access;
+}
+
+uint32_t DeviceModel_access(const char *name, volatile uint8_t *addr, uint32_t value, bool write)
+{
+    if (!write)
+    {
+        // Reads are served from the BAR images.
+        return value;
+    }
+
+    unordered_map<uintptr_t, model_register_t>::iterator it = gModel->registers.find((uintptr_t)addr);
+    if (it != gModel->registers.end())
+    {
+        value = it->second.handler(it->second.index, value);
+    }
+
+    return value;
+}
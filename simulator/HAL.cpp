@@ -12,6 +12,8 @@
 #include <bcm5719_GEN.h>
 #include <APE_NVIC.h>
 #include <APE_FILTERS.h>
+#include <MMIOTrace.h>
+#include <DeviceModel.h>
 
 #include <dirent.h>
 #include <endian.h>
@@ -28,6 +30,8 @@
 #include <unistd.h>
 
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <iostream>
 
 #if __has_include("valgrind/valgrind.h")
@@ -39,6 +43,11 @@
 using namespace std;
 
 #define DEVICE_ROOT     "/sys/bus/pci/devices/"
+#define REPLAY_PREFIX   "replay://"
+#define MODEL_PREFIX    "model://"
+#define ENV_TRACE       "BCM5719_TRACE"
+#define ENV_REPLAY      "BCM5719_REPLAY"
+#define ENV_MODEL       "BCM5719_MODEL"
 #define DEVICE_CONFIG   "config"
 #define BAR_STR         "resource"
 
@@ -87,6 +96,27 @@ uint32_t get_bar_addr(uint32_t bar)
 #define MAX_NUM_BARS 8
 uint8_t *bar[MAX_NUM_BARS] = {0};
 
+static uint32_t read_from_bar(uint32_t val, uint32_t offset, void *args)
+{
+    return CXXRegisterBase::loadMMIO(NULL, (uint8_t *)args + offset, sizeof(uint32_t));
+}
+
+static uint32_t write_to_bar(uint32_t val, uint32_t offset, void *args)
+{
+    CXXRegisterBase::storeMMIO(NULL, (uint8_t *)args + offset, sizeof(uint32_t), val);
+    return val;
+}
+
+// Route indexed accesses (e.g. SHM.write()) through the MMIO hook as well.
+template <typename T> static void install_index_callbacks(T &block, uint8_t *base)
+{
+    block.mIndexReadCallback = read_from_bar;
+    block.mIndexReadCallbackArgs = base;
+
+    block.mIndexWriteCallback = write_to_bar;
+    block.mIndexWriteCallbackArgs = base;
+}
+
 uint32_t read_device_chipid(uint32_t)
 {
     printf("DEIVCE CHIP ID\n");
@@ -111,9 +141,9 @@ bool is_pci_function(const char *pci_path, int wanted_function)
     return false;
 }
 
-static char* locate_pci_path(int wanted_function)
+vector<string> locateDevices(int wanted_function)
 {
-    char* pci_path = NULL;
+    vector<string> devices;
     struct dirent *pDirent;
     DIR *pDir;
 
@@ -121,10 +151,10 @@ static char* locate_pci_path(int wanted_function)
     if (pDir == NULL)
     {
         printf("Cannot open directory '%s'\n", DEVICE_ROOT);
-        return NULL;
+        return devices;
     }
 
-    while ((pDirent = readdir(pDir)) != NULL && NULL == pci_path)
+    while ((pDirent = readdir(pDir)) != NULL)
     {
         const char *pPCIPath = pDirent->d_name;
         if (is_pci_function(pDirent->d_name, wanted_function))
@@ -146,9 +176,7 @@ static char* locate_pci_path(int wanted_function)
                 {
                     if (is_supported(config.vendor_id, config.device_id))
                     {
-                        pci_path = (char *)malloc(
-                            strlen(DEVICE_ROOT "%s/") + strlen(pPCIPath) + 1);
-                        sprintf(pci_path, DEVICE_ROOT "%s/", pPCIPath);
+                        devices.push_back(string(DEVICE_ROOT) + pPCIPath + "/");
                     }
                 }
                 fclose(pConfigFile);
@@ -158,9 +186,69 @@ static char* locate_pci_path(int wanted_function)
     }
     closedir(pDir);
 
-    return pci_path;
+    // readdir() order is arbitrary, keep the selection stable between runs.
+    sort(devices.begin(), devices.end());
+
+    return devices;
 }
 
+static char* locate_pci_path(int wanted_function)
+{
+    vector<string> devices = locateDevices(wanted_function);
+    if (devices.empty())
+    {
+        return NULL;
+    }
+
+    return strdup(devices[0].c_str());
+}
+
+
+static void init_blocks(uint8_t *DEVICEBase, uint8_t *APEBase)
+{
+    init_bcm5719_DEVICE();
+    init_bcm5719_DEVICE_sim(DEVICEBase);
+    install_index_callbacks(DEVICE, DEVICEBase);
+
+    init_bcm5719_GEN();
+    init_bcm5719_GEN_sim(&DEVICEBase[0x8000 + 0xB50]); // 0x8000 for windowed area
+    install_index_callbacks(GEN, &DEVICEBase[0x8000 + 0xB50]);
+
+    init_bcm5719_NVM();
+    init_bcm5719_NVM_sim(&DEVICEBase[0x7000]);
+    install_index_callbacks(NVM, &DEVICEBase[0x7000]);
+
+    init_bcm5719_APE();
+    init_bcm5719_APE_sim(APEBase);
+    install_index_callbacks(APE, APEBase);
+
+    init_bcm5719_APE_PERI();
+    init_bcm5719_APE_PERI_sim(&APEBase[0x8000]);
+    install_index_callbacks(APE_PERI, &APEBase[0x8000]);
+
+    init_bcm5719_SHM();
+    init_bcm5719_SHM_sim(&APEBase[0x4000]);
+    install_index_callbacks(SHM, &APEBase[0x4000]);
+
+    init_bcm5719_SHM_CHANNEL0();
+    init_bcm5719_SHM_CHANNEL0_sim(&APEBase[0x4900]);
+    install_index_callbacks(SHM_CHANNEL0, &APEBase[0x4900]);
+    init_bcm5719_SHM_CHANNEL1();
+    init_bcm5719_SHM_CHANNEL1_sim(&APEBase[0x4a00]);
+    install_index_callbacks(SHM_CHANNEL1, &APEBase[0x4a00]);
+    init_bcm5719_SHM_CHANNEL2();
+    init_bcm5719_SHM_CHANNEL2_sim(&APEBase[0x4b00]);
+    install_index_callbacks(SHM_CHANNEL2, &APEBase[0x4b00]);
+    init_bcm5719_SHM_CHANNEL3();
+    init_bcm5719_SHM_CHANNEL3_sim(&APEBase[0x4c00]);
+    install_index_callbacks(SHM_CHANNEL3, &APEBase[0x4c00]);
+
+    init_APE_FILTERS();
+    init_APE_FILTERS_sim(NULL);
+
+    init_APE_NVIC();
+    init_APE_NVIC_sim(NULL);
+}
 
 bool initHAL(const char *pci_path, int wanted_function)
 {
@@ -168,6 +256,52 @@ bool initHAL(const char *pci_path, int wanted_function)
     struct stat st;
     int memfd;
 
+    const char *trace_path = getenv(ENV_TRACE);
+    if (trace_path && !MMIOTrace_start(trace_path))
+    {
+        return false;
+    }
+
+    string device_path = pci_path ? pci_path : "";
+    if (!pci_path && getenv(ENV_REPLAY))
+    {
+        device_path = string(REPLAY_PREFIX) + getenv(ENV_REPLAY);
+    }
+    else if (!pci_path && getenv(ENV_MODEL))
+    {
+        device_path = string(MODEL_PREFIX) + getenv(ENV_MODEL);
+    }
+
+    if (0 == device_path.compare(0, strlen(REPLAY_PREFIX), REPLAY_PREFIX))
+    {
+        // Serve all register accesses from a recorded trace.
+        if (!MMIOReplay_open(device_path.c_str() + strlen(REPLAY_PREFIX)))
+        {
+            return false;
+        }
+
+        init_blocks(MMIOReplay_getBAR(0), MMIOReplay_getBAR(2));
+        return true;
+    }
+
+    if (0 == device_path.compare(0, strlen(MODEL_PREFIX), MODEL_PREFIX))
+    {
+        // Use the in-process software model of the device.
+        if (!DeviceModel_init(device_path.c_str() + strlen(MODEL_PREFIX)))
+        {
+            return false;
+        }
+
+        for (unsigned int i = 0; DeviceModel_getBAR(i); i++)
+        {
+            MMIOTrace_setBAR(i, DeviceModel_getBAR(i), DEVICE_MODEL_BAR_SIZE);
+        }
+
+        init_blocks(DeviceModel_getBAR(0), DeviceModel_getBAR(2));
+        DeviceModel_bind();
+        return true;
+    }
+
     if(RUNNING_ON_VALGRIND)
     {
         cerr << "Running on valgrind is not supported when mmaping device registers." << endl;
@@ -234,6 +368,7 @@ bool initHAL(const char *pci_path, int wanted_function)
                            strerror(errno));
                     return false;
                 }
+                MMIOTrace_setBAR(i, bar[i], st.st_size);
 
                 if (is_bar_64bit(config.BAR[i]))
                 {
@@ -248,41 +383,7 @@ bool initHAL(const char *pci_path, int wanted_function)
         free(located_pci_path);
     }
 
-    uint8_t *DEVICEBase = (uint8_t *)bar[0];
-    uint8_t *APEBase = (uint8_t *)bar[2];
-
-    init_bcm5719_DEVICE();
-    init_bcm5719_DEVICE_sim(DEVICEBase);
-
-    init_bcm5719_GEN();
-    init_bcm5719_GEN_sim(&DEVICEBase[0x8000 + 0xB50]); // 0x8000 for windowed area
-
-    init_bcm5719_NVM();
-    init_bcm5719_NVM_sim(&DEVICEBase[0x7000]);
-
-    init_bcm5719_APE();
-    init_bcm5719_APE_sim(APEBase);
-
-    init_bcm5719_APE_PERI();
-    init_bcm5719_APE_PERI_sim(&APEBase[0x8000]);
-
-    init_bcm5719_SHM();
-    init_bcm5719_SHM_sim(&APEBase[0x4000]);
-
-    init_bcm5719_SHM_CHANNEL0();
-    init_bcm5719_SHM_CHANNEL0_sim(&APEBase[0x4900]);
-    init_bcm5719_SHM_CHANNEL1();
-    init_bcm5719_SHM_CHANNEL1_sim(&APEBase[0x4a00]);
-    init_bcm5719_SHM_CHANNEL2();
-    init_bcm5719_SHM_CHANNEL2_sim(&APEBase[0x4b00]);
-    init_bcm5719_SHM_CHANNEL3();
-    init_bcm5719_SHM_CHANNEL3_sim(&APEBase[0x4c00]);
-
-    init_APE_FILTERS();
-    init_APE_FILTERS_sim(NULL);
-
-    init_APE_NVIC();
-    init_APE_NVIC_sim(NULL);
+    init_blocks(bar[0], bar[2]);
 
     return true;
 }
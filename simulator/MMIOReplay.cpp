@@ -0,0 +1,314 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       MMIOReplay.cpp
+///
+/// @project    
+///
+/// @brief      Replay of recorded MMIO traces
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#include <MMIOTrace.h>
+#include <CXXRegister.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+#define MAX_BARS            8
+#define MIN_BAR_SIZE        (64 * 1024)
+#define MAX_REPORTED_ERRORS 10
+
+typedef struct
+{
+    vector<uint32_t> reads;
+    vector<uint32_t> writes;
+    size_t readPos;
+    size_t writePos;
+} replay_location_t;
+
+typedef struct
+{
+    uint64_t reads;
+    uint64_t writes;
+} replay_count_t;
+
+typedef struct
+{
+    uint8_t *bars[MAX_BARS];
+    size_t barSizes[MAX_BARS];
+
+    // Recorded values, indexed by (bar << 32) | offset.
+    unordered_map<uint64_t, replay_location_t> locations;
+
+    map<string, replay_count_t> recorded;
+    map<string, replay_count_t> replayed;
+
+    uint64_t reads;
+    uint64_t writes;
+    uint64_t unrecordedReads;
+    uint64_t extraWrites;
+    uint64_t mismatchedWrites;
+} replay_state_t;
+
+static replay_state_t *gReplay;
+static bool gAtExitInstalled;
+
+static inline uint64_t location_key(unsigned int bar, uint32_t offset)
+{
+    return ((uint64_t)bar << 32) | offset;
+}
+
+static bool load_trace(replay_state_t *replay, FILE *file)
+{
+    mmio_trace_header_t header;
+    if (1 != fread(&header, sizeof(header), 1, file) ||
+        0 != memcmp(header.magic, MMIO_TRACE_MAGIC, sizeof(header.magic)) ||
+        MMIO_TRACE_VERSION != header.version ||
+        sizeof(mmio_trace_entry_t) != header.entry_size)
+    {
+        fprintf(stderr, "Unsupported trace file.\n");
+        return false;
+    }
+
+    map<uint16_t, string> names;
+    names[MMIO_TRACE_NO_NAME] = "(raw)";
+
+    mmio_trace_entry_t entry;
+    while (1 == fread(&entry, sizeof(entry), 1, file))
+    {
+        if (MMIO_TRACE_NAME == entry.type)
+        {
+            string name(entry.value, '\0');
+            if (entry.value && 1 != fread(&name[0], entry.value, 1, file))
+            {
+                fprintf(stderr, "Truncated trace file.\n");
+                return false;
+            }
+            names[entry.name] = name;
+            continue;
+        }
+
+        if (entry.bar >= MAX_BARS)
+        {
+            // Not in a mapped BAR, nothing to replay.
+            continue;
+        }
+
+        size_t end = (size_t)entry.offset + sizeof(uint32_t);
+        if (end > replay->barSizes[entry.bar])
+        {
+            replay->barSizes[entry.bar] = end;
+        }
+
+        replay_location_t &location = replay->locations[location_key(entry.bar, entry.offset)];
+        replay_count_t &count = replay->recorded[names[entry.name]];
+        if (MMIO_TRACE_WRITE == entry.type)
+        {
+            location.writes.push_back(entry.value);
+            count.writes++;
+        }
+        else
+        {
+            location.reads.push_back(entry.value);
+            count.reads++;
+        }
+    }
+
+    return true;
+}
+
+bool MMIOReplay_open(const char *path)
+{
+    if (gReplay)
+    {
+        return false;
+    }
+
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        fprintf(stderr, "Unable to open trace file %s\n", path);
+        return false;
+    }
+
+    replay_state_t *replay = new replay_state_t();
+    bool loaded = load_trace(replay, file);
+    fclose(file);
+
+    if (!loaded)
+    {
+        delete replay;
+        return false;
+    }
+
+    for (unsigned int i = 0; i < MAX_BARS; i++)
+    {
+        if (replay->barSizes[i] < MIN_BAR_SIZE)
+        {
+            replay->barSizes[i] = MIN_BAR_SIZE;
+        }
+        replay->bars[i] = (uint8_t *)calloc(1, replay->barSizes[i]);
+    }
+
+    printf("Replaying %s: %zu register locations\n", path, replay->locations.size());
+
+    gReplay = replay;
+    CXXRegisterBase::mmioBackend() = MMIOReplay_access;
+
+    if (!gAtExitInstalled)
+    {
+        gAtExitInstalled = true;
+        atexit(MMIOReplay_close);
+    }
+
+    return true;
+}
+
+uint8_t *MMIOReplay_getBAR(unsigned int bar)
+{
+    if (!gReplay || bar >= MAX_BARS)
+    {
+        return NULL;
+    }
+
+    return gReplay->bars[bar];
+}
+
+uint32_t MMIOReplay_access(const char *name, volatile uint8_t *addr, uint32_t value, bool write)
+{
+    replay_state_t *replay = gReplay;
+    replay_location_t *location = NULL;
+    unsigned int bar;
+
+    for (bar = 0; bar < MAX_BARS; bar++)
+    {
+        volatile uint8_t *base = replay->bars[bar];
+        if (addr >= base && addr < base + replay->barSizes[bar])
+        {
+            unordered_map<uint64_t, replay_location_t>::iterator it =
+                replay->locations.find(location_key(bar, addr - base));
+            if (it != replay->locations.end())
+            {
+                location = &it->second;
+            }
+            break;
+        }
+    }
+
+    replay_count_t &count = replay->replayed[name ? name : "(raw)"];
+    if (write)
+    {
+        replay->writes++;
+        count.writes++;
+
+        if (!location || location->writePos >= location->writes.size())
+        {
+            replay->extraWrites++;
+        }
+        else if (location->writes[location->writePos++] != value)
+        {
+            if (replay->mismatchedWrites++ < MAX_REPORTED_ERRORS)
+            {
+                fprintf(stderr, "Replay: write of 0x%08X to %s (BAR%u) expected 0x%08X\n",
+                        value, name ? name : "(raw)", bar, location->writes[location->writePos - 1]);
+            }
+        }
+
+        return value;
+    }
+
+    replay->reads++;
+    count.reads++;
+
+    if (!location || location->reads.empty())
+    {
+        // Not read in the trace, return the backing memory (last write).
+        replay->unrecordedReads++;
+        return value;
+    }
+
+    if (location->readPos < location->reads.size())
+    {
+        return location->reads[location->readPos++];
+    }
+
+    // Polling past the end of the trace, the last value is stable.
+    return location->reads.back();
+}
+
+void MMIOReplay_close(void)
+{
+    replay_state_t *replay = gReplay;
+    if (!replay)
+    {
+        return;
+    }
+
+    CXXRegisterBase::mmioBackend() = NULL;
+
+    printf("Replay: %llu reads (%llu not recorded), %llu writes (%llu mismatched, %llu not recorded)\n",
+           (unsigned long long)replay->reads, (unsigned long long)replay->unrecordedReads,
+           (unsigned long long)replay->writes, (unsigned long long)replay->mismatchedWrites,
+           (unsigned long long)replay->extraWrites);
+
+    // Report registers whose access count changed since the trace was recorded.
+    map<string, replay_count_t> all = replay->recorded;
+    all.insert(replay->replayed.begin(), replay->replayed.end());
+    for (map<string, replay_count_t>::iterator it = all.begin(); it != all.end(); it++)
+    {
+        replay_count_t before = replay->recorded[it->first];
+        replay_count_t after = replay->replayed[it->first];
+        if (before.reads != after.reads || before.writes != after.writes)
+        {
+            printf("  %-32s reads %llu -> %llu, writes %llu -> %llu\n", it->first.c_str(),
+                   (unsigned long long)before.reads, (unsigned long long)after.reads,
+                   (unsigned long long)before.writes, (unsigned long long)after.writes);
+        }
+    }
+
+    // The BAR memory stays allocated, registers may still point into it.
+    gReplay = NULL;
+    delete replay;
+}
@@ -0,0 +1,333 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       MMIOTrace.cpp
+///
+/// @project    
+///
+/// @brief      Binary MMIO trace recorder
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#include <MMIOTrace.h>
+#include <CXXRegister.h>
+
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#define RING_ENTRIES    (1u << 16) /* Must be a power of two. */
+#define MAX_BARS        8
+#define FLUSH_IDLE_US   1000
+
+typedef struct
+{
+    std::atomic<uint64_t> seq;
+    uint64_t timestamp;
+    volatile uint8_t *addr;
+    const char *name;
+    uint32_t value;
+    bool write;
+} trace_slot_t;
+
+typedef struct
+{
+    volatile uint8_t *base;
+    size_t size;
+} trace_bar_t;
+
+typedef struct
+{
+    uint64_t reads;
+    uint64_t writes;
+} trace_count_t;
+
+typedef struct
+{
+    FILE *file;
+    std::thread flusher;
+    std::atomic<bool> running;
+
+    trace_slot_t *ring;
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+
+    std::chrono::steady_clock::time_point start;
+
+    // Flush thread state.
+    map<const char *, uint16_t> nameIds;
+    map<string, uint16_t> nameText;
+    map<string, trace_count_t> counts;
+    trace_count_t total;
+} trace_state_t;
+
+static trace_bar_t gBARs[MAX_BARS];
+static trace_state_t *gTrace;
+static bool gAtExitInstalled;
+
+void MMIOTrace_setBAR(unsigned int bar, volatile uint8_t *base, size_t size)
+{
+    if (bar < MAX_BARS)
+    {
+        gBARs[bar].base = base;
+        gBARs[bar].size = size;
+    }
+}
+
+uint32_t MMIOTrace_record(const char *name, volatile uint8_t *addr, uint32_t value, bool write)
+{
+    trace_state_t *trace = gTrace;
+    uint64_t index = trace->head.fetch_add(1, std::memory_order_relaxed);
+
+    while (index - trace->tail.load(std::memory_order_acquire) >= RING_ENTRIES)
+    {
+        // Ring is full, wait for the flush thread.
+        sched_yield();
+    }
+
+    trace_slot_t *slot = &trace->ring[index & (RING_ENTRIES - 1)];
+    slot->timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - trace->start).count();
+    slot->addr = addr;
+    slot->name = name;
+    slot->value = value;
+    slot->write = write;
+    slot->seq.store(index + 1, std::memory_order_release);
+
+    return value;
+}
+
+static uint16_t name_id(trace_state_t *trace, const char *name)
+{
+    if (!name)
+    {
+        return MMIO_TRACE_NO_NAME;
+    }
+
+    map<const char *, uint16_t>::iterator it = trace->nameIds.find(name);
+    if (it != trace->nameIds.end())
+    {
+        return it->second;
+    }
+
+    // Several registers may share a name string, only emit each name once.
+    uint16_t id;
+    map<string, uint16_t>::iterator text = trace->nameText.find(name);
+    if (text != trace->nameText.end())
+    {
+        id = text->second;
+    }
+    else
+    {
+        id = trace->nameText.size() + 1;
+        trace->nameText[name] = id;
+
+        mmio_trace_entry_t entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.type = MMIO_TRACE_NAME;
+        entry.name = id;
+        entry.value = strlen(name);
+        fwrite(&entry, sizeof(entry), 1, trace->file);
+        fwrite(name, entry.value, 1, trace->file);
+    }
+
+    trace->nameIds[name] = id;
+    return id;
+}
+
+static void write_slot(trace_state_t *trace, trace_slot_t *slot)
+{
+    mmio_trace_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+
+    entry.timestamp = slot->timestamp;
+    entry.value = slot->value;
+    entry.type = slot->write ? MMIO_TRACE_WRITE : MMIO_TRACE_READ;
+    entry.name = name_id(trace, slot->name);
+    entry.bar = MMIO_TRACE_BAR_UNKNOWN;
+    entry.offset = (uint32_t)(uintptr_t)slot->addr;
+
+    for (unsigned int i = 0; i < MAX_BARS; i++)
+    {
+        trace_bar_t *bar = &gBARs[i];
+        if (bar->base && slot->addr >= bar->base && slot->addr < bar->base + bar->size)
+        {
+            entry.bar = i;
+            entry.offset = slot->addr - bar->base;
+            break;
+        }
+    }
+
+    fwrite(&entry, sizeof(entry), 1, trace->file);
+
+    trace_count_t &count = trace->counts[slot->name ? slot->name : "(raw)"];
+    if (slot->write)
+    {
+        count.writes++;
+        trace->total.writes++;
+    }
+    else
+    {
+        count.reads++;
+        trace->total.reads++;
+    }
+}
+
+static bool flush(trace_state_t *trace)
+{
+    bool flushed = false;
+    uint64_t tail = trace->tail.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        trace_slot_t *slot = &trace->ring[tail & (RING_ENTRIES - 1)];
+        if (slot->seq.load(std::memory_order_acquire) != tail + 1)
+        {
+            break;
+        }
+
+        write_slot(trace, slot);
+        tail++;
+        trace->tail.store(tail, std::memory_order_release);
+        flushed = true;
+    }
+
+    return flushed;
+}
+
+static void flush_thread(trace_state_t *trace)
+{
+    while (trace->running.load(std::memory_order_acquire))
+    {
+        if (!flush(trace))
+        {
+            usleep(FLUSH_IDLE_US);
+        }
+    }
+
+    flush(trace);
+}
+
+bool MMIOTrace_start(const char *path)
+{
+    if (gTrace)
+    {
+        return false;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        fprintf(stderr, "Unable to open trace file %s\n", path);
+        return false;
+    }
+
+    mmio_trace_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MMIO_TRACE_MAGIC, sizeof(header.magic));
+    header.version = MMIO_TRACE_VERSION;
+    header.entry_size = sizeof(mmio_trace_entry_t);
+    fwrite(&header, sizeof(header), 1, file);
+
+    trace_state_t *trace = new trace_state_t();
+    trace->file = file;
+    trace->ring = new trace_slot_t[RING_ENTRIES]();
+    trace->head = 0;
+    trace->tail = 0;
+    trace->total.reads = 0;
+    trace->total.writes = 0;
+    trace->start = std::chrono::steady_clock::now();
+    trace->running = true;
+    trace->flusher = std::thread(flush_thread, trace);
+
+    gTrace = trace;
+    CXXRegisterBase::mmioHook() = MMIOTrace_record;
+
+    if (!gAtExitInstalled)
+    {
+        gAtExitInstalled = true;
+        atexit(MMIOTrace_stop);
+    }
+
+    return true;
+}
+
+static bool by_accesses(const pair<string, trace_count_t> &a, const pair<string, trace_count_t> &b)
+{
+    return (a.second.reads + a.second.writes) > (b.second.reads + b.second.writes);
+}
+
+void MMIOTrace_stop(void)
+{
+    trace_state_t *trace = gTrace;
+    if (!trace)
+    {
+        return;
+    }
+
+    CXXRegisterBase::mmioHook() = NULL;
+
+    trace->running = false;
+    trace->flusher.join();
+    fclose(trace->file);
+
+    printf("MMIO trace: %llu reads, %llu writes\n",
+           (unsigned long long)trace->total.reads, (unsigned long long)trace->total.writes);
+
+    vector< pair<string, trace_count_t> > sorted(trace->counts.begin(), trace->counts.end());
+    sort(sorted.begin(), sorted.end(), by_accesses);
+    for (size_t i = 0; i < sorted.size() && i < 10; i++)
+    {
+        printf("  %-32s %10llu reads %10llu writes\n", sorted[i].first.c_str(),
+               (unsigned long long)sorted[i].second.reads,
+               (unsigned long long)sorted[i].second.writes);
+    }
+
+    gTrace = NULL;
+    delete[] trace->ring;
+    delete trace;
+}
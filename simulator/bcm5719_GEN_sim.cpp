@@ -82,96 +82,73 @@ void init_bcm5719_GEN_sim(void *base)
 
     /** @brief Component Registers for @ref GEN. */
     /** @brief Bitmap for @ref GEN_t.GenFwMbox. */
-    GEN.GenFwMbox.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenFwMbox.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenFwMbox.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenDataSig. */
-    GEN.GenDataSig.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenDataSig.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenDataSig.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenCfg. */
-    GEN.GenCfg.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenCfg.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenCfg.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenVersion. */
-    GEN.GenVersion.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenVersion.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenVersion.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenPhyId. */
-    GEN.GenPhyId.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenPhyId.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenPhyId.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenAsfStatusMbox. */
-    GEN.GenAsfStatusMbox.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenAsfStatusMbox.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenAsfStatusMbox.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenFwDriverStateMbox. */
-    GEN.GenFwDriverStateMbox.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenFwDriverStateMbox.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenFwDriverStateMbox.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenFwResetTypeMbox. */
-    GEN.GenFwResetTypeMbox.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenFwResetTypeMbox.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenFwResetTypeMbox.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenBc. */
-    GEN.GenBc.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenBc.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenBc.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenMacAddrHighMbox. */
-    GEN.GenMacAddrHighMbox.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenMacAddrHighMbox.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenMacAddrHighMbox.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenMacAddrLowMbox. */
-    GEN.GenMacAddrLowMbox.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenMacAddrLowMbox.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenMacAddrLowMbox.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenD8. */
-    GEN.GenD8.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenD8.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenD8.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.Gen1dc. */
-    GEN.Gen1dc.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.Gen1dc.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.Gen1dc.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenWolMbox. */
-    GEN.GenWolMbox.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenWolMbox.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenWolMbox.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenCfgFeature. */
-    GEN.GenCfgFeature.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenCfgFeature.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenCfgFeature.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenCfgHw. */
-    GEN.GenCfgHw.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenCfgHw.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenCfgHw.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenCfgShared. */
-    GEN.GenCfgShared.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenCfgShared.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenCfgShared.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenFwVersion. */
-    GEN.GenFwVersion.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenFwVersion.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenFwVersion.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenCfgHw2. */
-    GEN.GenCfgHw2.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenCfgHw2.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenCfgHw2.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenCpmuStatus. */
-    GEN.GenCpmuStatus.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenCpmuStatus.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenCpmuStatus.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenCfg5. */
-    GEN.GenCfg5.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenCfg5.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenCfg5.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenDbgControlStatus. */
-    GEN.GenDbgControlStatus.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenDbgControlStatus.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenDbgControlStatus.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref GEN_t.GenDbgData. */
-    GEN.GenDbgData.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    GEN.GenDbgData.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    GEN.GenDbgData.r32.setMMIOBase((uint8_t *)base);
 
 
 }
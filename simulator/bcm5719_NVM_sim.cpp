@@ -82,52 +82,40 @@ void init_bcm5719_NVM_sim(void *base)
 
     /** @brief Component Registers for @ref NVM. */
     /** @brief Bitmap for @ref NVM_t.Command. */
-    NVM.Command.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.Command.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.Command.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref NVM_t.Write. */
-    NVM.Write.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.Write.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.Write.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref NVM_t.Addr. */
-    NVM.Addr.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.Addr.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.Addr.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref NVM_t.Read. */
-    NVM.Read.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.Read.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.Read.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref NVM_t.NvmCfg1. */
-    NVM.NvmCfg1.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.NvmCfg1.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.NvmCfg1.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref NVM_t.NvmCfg2. */
-    NVM.NvmCfg2.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.NvmCfg2.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.NvmCfg2.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref NVM_t.NvmCfg3. */
-    NVM.NvmCfg3.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.NvmCfg3.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.NvmCfg3.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref NVM_t.SoftwareArbitration. */
-    NVM.SoftwareArbitration.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.SoftwareArbitration.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.SoftwareArbitration.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref NVM_t.Access. */
-    NVM.Access.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.Access.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.Access.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref NVM_t.NvmWrite1. */
-    NVM.NvmWrite1.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.NvmWrite1.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.NvmWrite1.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref NVM_t.ArbitrationWatchdog. */
-    NVM.ArbitrationWatchdog.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.ArbitrationWatchdog.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.ArbitrationWatchdog.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref NVM_t.AutoSenseStatus. */
-    NVM.AutoSenseStatus.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    NVM.AutoSenseStatus.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    NVM.AutoSenseStatus.r32.setMMIOBase((uint8_t *)base);
 
 
 }
@@ -82,164 +82,124 @@ void init_bcm5719_SHM_CHANNEL0_sim(void *base)
 
     /** @brief Component Registers for @ref SHM_CHANNEL0. */
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelInfo. */
-    SHM_CHANNEL0.NcsiChannelInfo.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelInfo.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelInfo.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMcid. */
-    SHM_CHANNEL0.NcsiChannelMcid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMcid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMcid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAen. */
-    SHM_CHANNEL0.NcsiChannelAen.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelAen.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelAen.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelBfilt. */
-    SHM_CHANNEL0.NcsiChannelBfilt.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelBfilt.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelBfilt.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMfilt. */
-    SHM_CHANNEL0.NcsiChannelMfilt.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMfilt.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMfilt.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelSetting1. */
-    SHM_CHANNEL0.NcsiChannelSetting1.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelSetting1.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelSetting1.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelSetting2. */
-    SHM_CHANNEL0.NcsiChannelSetting2.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelSetting2.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelSetting2.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelVlan. */
-    SHM_CHANNEL0.NcsiChannelVlan.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelVlan.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelVlan.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAltHostMacHigh. */
-    SHM_CHANNEL0.NcsiChannelAltHostMacHigh.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelAltHostMacHigh.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelAltHostMacHigh.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAltHostMacMid. */
-    SHM_CHANNEL0.NcsiChannelAltHostMacMid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelAltHostMacMid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelAltHostMacMid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAltHostMacLow. */
-    SHM_CHANNEL0.NcsiChannelAltHostMacLow.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelAltHostMacLow.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelAltHostMacLow.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0High. */
-    SHM_CHANNEL0.NcsiChannelMac0High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac0High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac0High.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0Mid. */
-    SHM_CHANNEL0.NcsiChannelMac0Mid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac0Mid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac0Mid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0Low. */
-    SHM_CHANNEL0.NcsiChannelMac0Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac0Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac0Low.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1High. */
-    SHM_CHANNEL0.NcsiChannelMac1High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac1High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac1High.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1Mid. */
-    SHM_CHANNEL0.NcsiChannelMac1Mid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac1Mid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac1Mid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1Low. */
-    SHM_CHANNEL0.NcsiChannelMac1Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac1Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac1Low.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac2High. */
-    SHM_CHANNEL0.NcsiChannelMac2High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac2High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac2High.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac2Mid. */
-    SHM_CHANNEL0.NcsiChannelMac2Mid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac2Mid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac2Mid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac2Low. */
-    SHM_CHANNEL0.NcsiChannelMac2Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac2Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac2Low.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac3High. */
-    SHM_CHANNEL0.NcsiChannelMac3High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac3High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac3High.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac3Mid. */
-    SHM_CHANNEL0.NcsiChannelMac3Mid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac3Mid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac3Mid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac3Low. */
-    SHM_CHANNEL0.NcsiChannelMac3Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac3Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac3Low.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0VlanValid. */
-    SHM_CHANNEL0.NcsiChannelMac0VlanValid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac0VlanValid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac0VlanValid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0Vlan. */
-    SHM_CHANNEL0.NcsiChannelMac0Vlan.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac0Vlan.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac0Vlan.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1VlanValid. */
-    SHM_CHANNEL0.NcsiChannelMac1VlanValid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac1VlanValid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac1VlanValid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1Vlan. */
-    SHM_CHANNEL0.NcsiChannelMac1Vlan.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelMac1Vlan.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelMac1Vlan.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelStatus. */
-    SHM_CHANNEL0.NcsiChannelStatus.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelStatus.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelStatus.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelResetCount. */
-    SHM_CHANNEL0.NcsiChannelResetCount.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelResetCount.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelResetCount.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelPxe. */
-    SHM_CHANNEL0.NcsiChannelPxe.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelPxe.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelPxe.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelDropfil. */
-    SHM_CHANNEL0.NcsiChannelDropfil.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelDropfil.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelDropfil.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelSlink. */
-    SHM_CHANNEL0.NcsiChannelSlink.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelSlink.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelSlink.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelDbg. */
-    SHM_CHANNEL0.NcsiChannelDbg.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelDbg.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelDbg.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatRx. */
-    SHM_CHANNEL0.NcsiChannelCtrlstatRx.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelCtrlstatRx.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelCtrlstatRx.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatDropped. */
-    SHM_CHANNEL0.NcsiChannelCtrlstatDropped.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelCtrlstatDropped.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelCtrlstatDropped.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatTypeErr. */
-    SHM_CHANNEL0.NcsiChannelCtrlstatTypeErr.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelCtrlstatTypeErr.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelCtrlstatTypeErr.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatBadCsum. */
-    SHM_CHANNEL0.NcsiChannelCtrlstatBadCsum.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelCtrlstatBadCsum.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelCtrlstatBadCsum.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatAllRx. */
-    SHM_CHANNEL0.NcsiChannelCtrlstatAllRx.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelCtrlstatAllRx.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelCtrlstatAllRx.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatAllTx. */
-    SHM_CHANNEL0.NcsiChannelCtrlstatAllTx.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelCtrlstatAllTx.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelCtrlstatAllTx.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatAllAen. */
-    SHM_CHANNEL0.NcsiChannelCtrlstatAllAen.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL0.NcsiChannelCtrlstatAllAen.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL0.NcsiChannelCtrlstatAllAen.r32.setMMIOBase((uint8_t *)base);
 
 
 }
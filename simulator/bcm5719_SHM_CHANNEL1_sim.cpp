@@ -82,164 +82,124 @@ void init_bcm5719_SHM_CHANNEL1_sim(void *base)
 
     /** @brief Component Registers for @ref SHM_CHANNEL1. */
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelInfo. */
-    SHM_CHANNEL1.NcsiChannelInfo.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelInfo.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelInfo.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMcid. */
-    SHM_CHANNEL1.NcsiChannelMcid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMcid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMcid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAen. */
-    SHM_CHANNEL1.NcsiChannelAen.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelAen.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelAen.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelBfilt. */
-    SHM_CHANNEL1.NcsiChannelBfilt.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelBfilt.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelBfilt.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMfilt. */
-    SHM_CHANNEL1.NcsiChannelMfilt.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMfilt.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMfilt.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelSetting1. */
-    SHM_CHANNEL1.NcsiChannelSetting1.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelSetting1.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelSetting1.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelSetting2. */
-    SHM_CHANNEL1.NcsiChannelSetting2.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelSetting2.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelSetting2.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelVlan. */
-    SHM_CHANNEL1.NcsiChannelVlan.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelVlan.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelVlan.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAltHostMacHigh. */
-    SHM_CHANNEL1.NcsiChannelAltHostMacHigh.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelAltHostMacHigh.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelAltHostMacHigh.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAltHostMacMid. */
-    SHM_CHANNEL1.NcsiChannelAltHostMacMid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelAltHostMacMid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelAltHostMacMid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelAltHostMacLow. */
-    SHM_CHANNEL1.NcsiChannelAltHostMacLow.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelAltHostMacLow.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelAltHostMacLow.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0High. */
-    SHM_CHANNEL1.NcsiChannelMac0High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac0High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac0High.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0Mid. */
-    SHM_CHANNEL1.NcsiChannelMac0Mid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac0Mid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac0Mid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0Low. */
-    SHM_CHANNEL1.NcsiChannelMac0Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac0Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac0Low.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1High. */
-    SHM_CHANNEL1.NcsiChannelMac1High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac1High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac1High.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1Mid. */
-    SHM_CHANNEL1.NcsiChannelMac1Mid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac1Mid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac1Mid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1Low. */
-    SHM_CHANNEL1.NcsiChannelMac1Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac1Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac1Low.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac2High. */
-    SHM_CHANNEL1.NcsiChannelMac2High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac2High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac2High.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac2Mid. */
-    SHM_CHANNEL1.NcsiChannelMac2Mid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac2Mid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac2Mid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac2Low. */
-    SHM_CHANNEL1.NcsiChannelMac2Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac2Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac2Low.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac3High. */
-    SHM_CHANNEL1.NcsiChannelMac3High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac3High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac3High.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac3Mid. */
-    SHM_CHANNEL1.NcsiChannelMac3Mid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac3Mid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac3Mid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac3Low. */
-    SHM_CHANNEL1.NcsiChannelMac3Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac3Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac3Low.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0VlanValid. */
-    SHM_CHANNEL1.NcsiChannelMac0VlanValid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac0VlanValid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac0VlanValid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac0Vlan. */
-    SHM_CHANNEL1.NcsiChannelMac0Vlan.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac0Vlan.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac0Vlan.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1VlanValid. */
-    SHM_CHANNEL1.NcsiChannelMac1VlanValid.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac1VlanValid.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac1VlanValid.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelMac1Vlan. */
-    SHM_CHANNEL1.NcsiChannelMac1Vlan.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelMac1Vlan.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelMac1Vlan.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelStatus. */
-    SHM_CHANNEL1.NcsiChannelStatus.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelStatus.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelStatus.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelResetCount. */
-    SHM_CHANNEL1.NcsiChannelResetCount.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelResetCount.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelResetCount.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelPxe. */
-    SHM_CHANNEL1.NcsiChannelPxe.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelPxe.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelPxe.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelDropfil. */
-    SHM_CHANNEL1.NcsiChannelDropfil.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelDropfil.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelDropfil.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelSlink. */
-    SHM_CHANNEL1.NcsiChannelSlink.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelSlink.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelSlink.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelDbg. */
-    SHM_CHANNEL1.NcsiChannelDbg.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelDbg.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelDbg.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatRx. */
-    SHM_CHANNEL1.NcsiChannelCtrlstatRx.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelCtrlstatRx.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelCtrlstatRx.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatDropped. */
-    SHM_CHANNEL1.NcsiChannelCtrlstatDropped.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelCtrlstatDropped.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelCtrlstatDropped.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatTypeErr. */
-    SHM_CHANNEL1.NcsiChannelCtrlstatTypeErr.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelCtrlstatTypeErr.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelCtrlstatTypeErr.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatBadCsum. */
-    SHM_CHANNEL1.NcsiChannelCtrlstatBadCsum.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelCtrlstatBadCsum.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelCtrlstatBadCsum.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatAllRx. */
-    SHM_CHANNEL1.NcsiChannelCtrlstatAllRx.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelCtrlstatAllRx.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelCtrlstatAllRx.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatAllTx. */
-    SHM_CHANNEL1.NcsiChannelCtrlstatAllTx.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelCtrlstatAllTx.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelCtrlstatAllTx.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_CHANNEL_t.NcsiChannelCtrlstatAllAen. */
-    SHM_CHANNEL1.NcsiChannelCtrlstatAllAen.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM_CHANNEL1.NcsiChannelCtrlstatAllAen.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM_CHANNEL1.NcsiChannelCtrlstatAllAen.r32.setMMIOBase((uint8_t *)base);
 
 
 }
@@ -82,192 +82,161 @@ void init_bcm5719_SHM_sim(void *base)
 
     /** @brief Component Registers for @ref SHM. */
     /** @brief Bitmap for @ref SHM_t.SegSig. */
-    SHM.SegSig.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.SegSig.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.SegSig.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.ApeSegLength. */
-    SHM.ApeSegLength.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.ApeSegLength.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.ApeSegLength.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.FwStatus. */
-    SHM.FwStatus.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.FwStatus.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.FwStatus.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.FwFeatures. */
-    SHM.FwFeatures.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.FwFeatures.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.FwFeatures.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.4014. */
-    SHM._4014.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM._4014.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM._4014.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.FwVersion. */
-    SHM.FwVersion.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.FwVersion.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.FwVersion.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.SegMessageBufferOffset. */
-    SHM.SegMessageBufferOffset.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.SegMessageBufferOffset.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.SegMessageBufferOffset.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.SegMessageBufferLength. */
-    SHM.SegMessageBufferLength.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.SegMessageBufferLength.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.SegMessageBufferLength.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.4024. */
-    SHM._4024.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM._4024.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM._4024.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.4028. */
-    SHM._4028.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM._4028.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM._4028.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.LoaderCommand. */
-    SHM.LoaderCommand.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.LoaderCommand.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.LoaderCommand.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.LoaderArg0. */
-    SHM.LoaderArg0.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.LoaderArg0.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.LoaderArg0.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.LoaderArg1. */
-    SHM.LoaderArg1.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.LoaderArg1.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.LoaderArg1.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuSegSig. */
-    SHM.RcpuSegSig.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuSegSig.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuSegSig.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuSegLength. */
-    SHM.RcpuSegLength.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuSegLength.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuSegLength.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuInitCount. */
-    SHM.RcpuInitCount.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuInitCount.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuInitCount.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuFwVersion. */
-    SHM.RcpuFwVersion.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuFwVersion.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuFwVersion.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuCfgFeature. */
-    SHM.RcpuCfgFeature.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuCfgFeature.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuCfgFeature.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuPciVendorDeviceId. */
-    SHM.RcpuPciVendorDeviceId.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuPciVendorDeviceId.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuPciVendorDeviceId.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuPciSubsystemId. */
-    SHM.RcpuPciSubsystemId.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuPciSubsystemId.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuPciSubsystemId.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuApeResetCount. */
-    SHM.RcpuApeResetCount.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuApeResetCount.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuApeResetCount.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuLastApeStatus. */
-    SHM.RcpuLastApeStatus.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuLastApeStatus.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuLastApeStatus.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuLastApeFwStatus. */
-    SHM.RcpuLastApeFwStatus.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuLastApeFwStatus.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuLastApeFwStatus.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuCfgHw. */
-    SHM.RcpuCfgHw.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuCfgHw.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuCfgHw.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuCfgHw2. */
-    SHM.RcpuCfgHw2.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuCfgHw2.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuCfgHw2.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.RcpuCpmuStatus. */
-    SHM.RcpuCpmuStatus.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.RcpuCpmuStatus.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.RcpuCpmuStatus.r32.setMMIOBase((uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.RcpuBootTimelineCount. */
+    SHM.RcpuBootTimelineCount.r32.setMMIOBase((uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.RcpuBootTimeline. */
+    for(int i = 0; i < 48; i++)
+    {
+        SHM.RcpuBootTimeline[i].r32.setMMIOBase((uint8_t *)base);
+    }
 
     /** @brief Bitmap for @ref SHM_t.HostSegSig. */
-    SHM.HostSegSig.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.HostSegSig.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.HostSegSig.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.HostSegLen. */
-    SHM.HostSegLen.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.HostSegLen.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.HostSegLen.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.HostInitCount. */
-    SHM.HostInitCount.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.HostInitCount.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.HostInitCount.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.HostDriverId. */
-    SHM.HostDriverId.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.HostDriverId.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.HostDriverId.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.HostBehavior. */
-    SHM.HostBehavior.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.HostBehavior.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.HostBehavior.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.HeartbeatInterval. */
-    SHM.HeartbeatInterval.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.HeartbeatInterval.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.HeartbeatInterval.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.HeartbeatCount. */
-    SHM.HeartbeatCount.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.HeartbeatCount.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.HeartbeatCount.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.HostDriverState. */
-    SHM.HostDriverState.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.HostDriverState.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.HostDriverState.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.WolSpeed. */
-    SHM.WolSpeed.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.WolSpeed.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.WolSpeed.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.EventStatus. */
-    SHM.EventStatus.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.EventStatus.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.EventStatus.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.ProtMagic. */
-    SHM.ProtMagic.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.ProtMagic.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.ProtMagic.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.ProtMac0High. */
-    SHM.ProtMac0High.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.ProtMac0High.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.ProtMac0High.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.ProtMac0Low. */
-    SHM.ProtMac0Low.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.ProtMac0Low.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.ProtMac0Low.r32.setMMIOBase((uint8_t *)base);
+
+    /** @brief Bitmap for @ref SHM_t.LoaderBuffer. */
+    for(int i = 0; i < 256; i++)
+    {
+        SHM.LoaderBuffer[i].r32.setMMIOBase((uint8_t *)base);
+    }
 
     /** @brief Bitmap for @ref SHM_t.NcsiSig. */
-    SHM.NcsiSig.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.NcsiSig.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.NcsiSig.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.NcsiBuildTime. */
-    SHM.NcsiBuildTime.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.NcsiBuildTime.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.NcsiBuildTime.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.NcsiBuildTime2. */
-    SHM.NcsiBuildTime2.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.NcsiBuildTime2.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.NcsiBuildTime2.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.NcsiBuildTime3. */
-    SHM.NcsiBuildTime3.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.NcsiBuildTime3.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.NcsiBuildTime3.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.NcsiBuildDate. */
-    SHM.NcsiBuildDate.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.NcsiBuildDate.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.NcsiBuildDate.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.NcsiBuildDate2. */
-    SHM.NcsiBuildDate2.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.NcsiBuildDate2.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.NcsiBuildDate2.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.NcsiBuildDate3. */
-    SHM.NcsiBuildDate3.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.NcsiBuildDate3.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.NcsiBuildDate3.r32.setMMIOBase((uint8_t *)base);
 
     /** @brief Bitmap for @ref SHM_t.ChipId. */
-    SHM.ChipId.r32.installReadCallback(read_from_ram, (uint8_t *)base);
-    SHM.ChipId.r32.installWriteCallback(write_to_ram, (uint8_t *)base);
+    SHM.ChipId.r32.setMMIOBase((uint8_t *)base);
+    SHM.ChipId.r32.setCachePolicy(CXXRegisterBase::CACHE_READ_ONCE);
 
 
 }
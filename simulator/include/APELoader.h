@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       APELoader.h
+///
+/// @project    
+///
+/// @brief      Host side interface to the APE loader mailbox
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef APE_LOADER_H
+#define APE_LOADER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Read a single word of APE memory using the loader mailbox.
+ */
+uint32_t APELoader_readWord(uint32_t addr);
+
+/**
+ * @brief Write a single word of APE memory using the loader mailbox.
+ */
+void APELoader_writeWord(uint32_t addr, uint32_t value);
+
+/**
+ * @brief Register read callback for APE memory reached through the loader.
+ *
+ * @param args Base address of the register block in APE memory.
+ */
+uint32_t APELoader_readCallback(uint32_t val, uint32_t offset, void *args);
+
+/**
+ * @brief Register write callback for APE memory reached through the loader.
+ *
+ * @param args Base address of the register block in APE memory.
+ *
+ * @note The write is queued with APELoader_queueWrite when the command ring
+ *       is available. Reads and other loader commands flush it first.
+ */
+uint32_t APELoader_writeCallback(uint32_t val, uint32_t offset, void *args);
+
+/**
+ * @brief Read count words of APE memory starting at addr.
+ *
+ * @note Data is transferred through the SHM loader buffer, one READ_BLOCK
+ *       command per buffer instead of one mailbox round trip per word.
+ */
+void APELoader_readMem(uint32_t addr, uint32_t *words, size_t count);
+
+/**
+ * @brief Write count words to APE memory starting at addr.
+ */
+void APELoader_writeMem(uint32_t addr, const uint32_t *words, size_t count);
+
+/**
+ * @brief Fill count words of APE memory starting at addr with value.
+ */
+void APELoader_memset(uint32_t addr, uint32_t value, size_t count);
+
+/**
+ * @brief CRC of bytes of APE memory starting at addr, computed by the loader.
+ *
+ * @returns NVRam_crc(addr, bytes, 0xffffffff) as seen by the APE.
+ */
+uint32_t APELoader_crc(uint32_t addr, uint32_t bytes);
+
+/**
+ * @brief Write count words to APE memory starting at addr, compressing the
+ *        data on the host and expanding it on the APE.
+ *
+ * @note Chunks that do not compress well are written with WRITE_BLOCK and
+ *       all zero chunks with MEMSET.
+ *
+ * @returns the number of bytes sent through the staging buffer.
+ */
+size_t APELoader_writeCompressed(uint32_t addr, const uint32_t *words, size_t count);
+
+/**
+ * @brief Locate the command ring advertised by a running loader.
+ *
+ * @returns true if the ring is usable. Otherwise the queue functions fall back
+ *          to the synchronous mailbox.
+ */
+bool APELoader_initRing(void);
+
+/**
+ * @brief Queue a write of a single word of APE memory.
+ *
+ * @note The write is only guaranteed to have completed after APELoader_flush.
+ */
+void APELoader_queueWrite(uint32_t addr, uint32_t value);
+
+/**
+ * @brief Queue a read of a single word of APE memory.
+ *
+ * @note value is only updated once the command completes, at the latest on
+ *       APELoader_flush.
+ */
+void APELoader_queueRead(uint32_t addr, uint32_t *value);
+
+/**
+ * @brief Wait for all queued commands to complete.
+ */
+void APELoader_flush(void);
+
+#endif /* APE_LOADER_H */
@@ -47,17 +47,59 @@
 #include <vector>
 #include <utility>
 #include <stdio.h>
+#include <stdint.h>
 #include <iostream>
 #include <iomanip>      // std::setw
 
+#ifdef __ppc64__
+#define CXX_REGISTER_BARRIER()    do { asm volatile ("sync 0\neieio\n" ::: "memory"); } while(0)
+#else
+#define CXX_REGISTER_BARRIER()    do { asm volatile ("" ::: "memory"); } while(0)
+#endif
+
+/**
+ * @brief Hook called for every direct MMIO access, see CXXRegisterBase::mmioHook.
+ *        For loads, the returned value replaces the value read.
+ */
+typedef uint32_t (*mmio_hook_t)(const char* name, volatile uint8_t* addr, uint32_t value, bool write);
+
 class CXXRegisterBase
 {
 public:
+    /**
+     * @brief How register reads may be served from the shadow value.
+     *
+     * Set by the generated *_sim.cpp bindings from the IP-XACT register
+     * description, see cache_policies in ipxact/regen.sh: registers marked
+     * non-volatile use CACHE_READ_ONCE if read-only and CACHE_WRITE_THROUGH
+     * otherwise. All other registers stay CACHE_VOLATILE.
+     */
+    typedef enum {
+        /** @brief Every read goes to the backend (default). */
+        CACHE_VOLATILE,
+        /** @brief Read from the backend once, writes invalidate the cache. */
+        CACHE_READ_ONCE,
+        /** @brief Read once, writes go to the backend and update the cache. */
+        CACHE_WRITE_THROUGH,
+    } cache_policy_t;
+
     CXXRegisterBase(unsigned int offset, unsigned int width)
     {
         mComponentOffset = 0;
         mMask = 0;
+        mName = NULL;
         mBaseRegister = NULL;
+        mValue = 0;
+        mTempValue = 0;
+        mMMIOBase = NULL;
+        mMMIOWidth = 0;
+        mHasReadCallbacks = false;
+        mHasWriteCallbacks = false;
+        mRelatedReadCallbacks = false;
+        mCachePolicy = CACHE_VOLATILE;
+        mCacheValid = false;
+        mTransactionDepth = 0;
+        mTransactionDirty = false;
         mBitWidth = width;
         mBitPosition = offset;
         for(unsigned int i = offset; i < offset + width; i++)
@@ -72,6 +114,10 @@ public:
 
         mBaseRegister = base;
         base->addRelatedRegister(this);
+        if(mHasReadCallbacks)
+        {
+            base->mRelatedReadCallbacks = true;
+        }
 
     }
 
@@ -85,6 +131,114 @@ public:
         return mName;
     }
 
+    void setCachePolicy(cache_policy_t policy)
+    {
+        mCachePolicy = policy;
+        mCacheValid = false;
+    }
+
+    cache_policy_t getCachePolicy(void)
+    {
+        return mCachePolicy;
+    }
+
+    /** @brief Force the next read of a cached register to go to the backend. */
+    void invalidateCache(void)
+    {
+        mCacheValid = false;
+    }
+
+    /**
+     * @brief Process wide hook for MMIO tracing. When set, it is called after
+     *        each load and before each store done through a bound register.
+     */
+    static mmio_hook_t& mmioHook(void)
+    {
+        static mmio_hook_t hook = NULL;
+        return hook;
+    }
+
+    /**
+     * @brief Process wide device backend, used to emulate the device behind
+     *        the MMIO memory. It is called closest to the memory: its return
+     *        value is used as the value loaded or stored.
+     */
+    static mmio_hook_t& mmioBackend(void)
+    {
+        static mmio_hook_t backend = NULL;
+        return backend;
+    }
+
+    /** @brief Load width bytes from addr through the MMIO hooks. */
+    static uint32_t loadMMIO(const char* name, volatile uint8_t* addr, unsigned int width)
+    {
+        uint32_t val;
+
+        CXX_REGISTER_BARRIER();
+        switch(width)
+        {
+            case 1:
+                val = *(volatile uint8_t*)addr;
+                break;
+            case 2:
+                val = *(volatile uint16_t*)addr;
+                break;
+            default:
+                val = *(volatile uint32_t*)addr;
+                break;
+        }
+
+        mmio_hook_t backend = mmioBackend();
+        if(backend)
+        {
+            val = backend(name, addr, val, false);
+        }
+
+        mmio_hook_t hook = mmioHook();
+        if(hook)
+        {
+            val = hook(name, addr, val, false);
+        }
+        return val;
+    }
+
+    /** @brief Store width bytes to addr through the MMIO hooks. */
+    static void storeMMIO(const char* name, volatile uint8_t* addr, unsigned int width, uint32_t val)
+    {
+        mmio_hook_t hook = mmioHook();
+        if(hook)
+        {
+            val = hook(name, addr, val, true);
+        }
+
+        mmio_hook_t backend = mmioBackend();
+        if(backend)
+        {
+            val = backend(name, addr, val, true);
+        }
+
+        CXX_REGISTER_BARRIER();
+        switch(width)
+        {
+            case 1:
+                *(volatile uint8_t*)addr = val;
+                break;
+            case 2:
+                *(volatile uint16_t*)addr = val;
+                break;
+            default:
+                *(volatile uint32_t*)addr = val;
+                break;
+        }
+        CXX_REGISTER_BARRIER();
+    }
+
+    /** @brief Address of a register bound with setMMIOBase, or NULL. */
+    volatile uint8_t* getMMIOAddress(void)
+    {
+        return mMMIOBase ? mMMIOBase + mComponentOffset : NULL;
+    }
+
     void setComponentOffset(unsigned int offset)
     {
         mComponentOffset = offset;
@@ -130,21 +284,131 @@ protected:
     // This is the main controller register
     CXXRegisterBase* mBaseRegister;
 
+    // Current and pending values, right aligned to the bitfield.
+    unsigned int mValue;
+    unsigned int mTempValue;
+
+    // Direct MMIO backend. When set and no callbacks are installed, accesses
+    // go straight to mMMIOBase + mComponentOffset.
+    volatile uint8_t* mMMIOBase;
+    unsigned int mMMIOWidth;
+    bool mHasReadCallbacks;
+    bool mHasWriteCallbacks;
+    // Set on a base register when any of its bitfields has read callbacks.
+    bool mRelatedReadCallbacks;
+
+    cache_policy_t mCachePolicy;
+    // Set once mValue holds the backend value of a cached register.
+    bool mCacheValid;
+
+    // Number of open RegisterTransaction objects on this (base) register.
+    unsigned int mTransactionDepth;
+    // Set when the shadow value was modified during a transaction.
+    bool mTransactionDirty;
+
+    friend class RegisterTransaction;
+
+    CXXRegisterBase* getBaseRegister(void)
+    {
+        return mBaseRegister ? mBaseRegister : this;
+    }
+
 
     virtual void addRelatedRegister(CXXRegisterBase* related)
     {
         mRelatedRegisters.push_back(related);
     }
 
-    // Virtual, must be re-implemented by subclasses
+    // Virtual, must be re-implemented by subclasses. Only called when
+    // callbacks have been installed on the register.
     virtual void doWriteCallbacks(void) = 0;
     virtual void doReadCallbacks(void) = 0;
 
-    virtual unsigned int getRawValue(void) = 0;
-    virtual unsigned int getTempValue(void) = 0;
-    virtual void setRawValue(unsigned int) = 0;
-    virtual void setTempValue(unsigned int) = 0;
+    unsigned int getRawValue(void)
+    {
+        return (mValue << mBitPosition) & mMask;
+    }
+
+    void setRawValue(unsigned int newVal)
+    {
+        mValue = (newVal & mMask) >> mBitPosition;
+    }
+
+    unsigned int getTempValue(void)
+    {
+        return (mTempValue << mBitPosition) & mMask;
+    }
+
+    void setTempValue(unsigned int newVal)
+    {
+        mTempValue = (newVal & mMask) >> mBitPosition;
+    }
+
+    unsigned int loadMMIO(void)
+    {
+        return loadMMIO(mName, mMMIOBase + mComponentOffset, mMMIOWidth);
+    }
+
+    void storeMMIO(unsigned int val)
+    {
+        storeMMIO(mName, mMMIOBase + mComponentOffset, mMMIOWidth, val);
+    }
+
+    void setHasReadCallbacks(void)
+    {
+        mHasReadCallbacks = true;
+        if(mBaseRegister)
+        {
+            mBaseRegister->mRelatedReadCallbacks = true;
+        }
+    }
+
+    // Fetch the latest value into mTempValue.
+    void readBackend(void)
+    {
+        if(mCacheValid)
+        {
+            mTempValue = mValue;
+        }
+        else if(mHasReadCallbacks)
+        {
+            doReadCallbacks();
+        }
+        else if(mMMIOBase)
+        {
+            mTempValue = loadMMIO();
+        }
+        else
+        {
+            mTempValue = mValue;
+        }
+
+        if(CACHE_VOLATILE != mCachePolicy && !mCacheValid)
+        {
+            mValue = mTempValue;
+            mCacheValid = true;
+        }
+    }
+
+    // Write mTempValue out and latch it into mValue.
+    void writeBackend(void)
+    {
+        if(mHasWriteCallbacks)
+        {
+            doWriteCallbacks();
+        }
+        else
+        {
+            if(mMMIOBase)
+            {
+                storeMMIO(mTempValue);
+            }
+            mValue = mTempValue;
+        }
 
+        // Only a write-through shadow knows the value after a write.
+        mCacheValid = (CACHE_WRITE_THROUGH == mCachePolicy);
+    }
 
     void doRelatedWritesBase(CXXRegisterBase* source)
     {
@@ -155,10 +419,19 @@ protected:
         // printf("Updating base from %x & %x to %x (new write: %x)\n", getRawValue(), ~source->mMask, tempValue, source->getRawValue());
         setTempValue(tempValue);
 
+        if(mTransactionDepth)
+        {
+            // Transaction in progress: only update the shadow value, the
+            // write callbacks are called once the transaction is committed.
+            setRawValue(tempValue);
+            mTransactionDirty = true;
+            return;
+        }
+
         // Call the write callbacks. This may update the raw value as needed.
         if(this != source)
         {
-            doWriteCallbacks();
+            writeBackend();
         }
     }
 
@@ -179,18 +452,44 @@ protected:
 
     void doRelatedReadsBase(CXXRegisterBase* source)
     {
-        // Read the latest from the base register.
-        doReadCallbacks();
+        if(mTransactionDepth)
+        {
+            // Transaction in progress: serve reads from the shadow value.
+            setTempValue(getRawValue());
+        }
+        else
+        {
+            // Read the latest from the base register.
+            readBackend();
+        }
         unsigned int readValue = getTempValue();
 
+        if(this != source && !mRelatedReadCallbacks)
+        {
+            // Plain bitfield read: only the requesting bitfield needs the
+            // new value, the others are refreshed when they are read.
+            source->setRawValue(readValue);
+            source->mTempValue = source->mValue;
+            setRawValue(readValue);
+            return;
+        }
+
         // Update chained registers.
         std::vector<CXXRegisterBase*>::iterator it;
         for(it = mRelatedRegisters.begin(); it != mRelatedRegisters.end(); it++)
         {
+            CXXRegisterBase* related = *it;
             // Update chained registers with latest data from base register.
-            (*it)->setRawValue(readValue);
+            related->setRawValue(readValue);
             // Update the temp value for all registers.
-            (*it)->doReadCallbacks();
+            if(related->mHasReadCallbacks)
+            {
+                related->doReadCallbacks();
+            }
+            else
+            {
+                related->mTempValue = related->mValue;
+            }
 
             // FIXME: handle updated from chained registers?
         }
@@ -205,14 +504,86 @@ protected:
         {
             mBaseRegister->doRelatedReadsBase(this);
         }
+        else if(mTransactionDepth)
+        {
+            // Transaction in progress: serve reads from the shadow value.
+            setTempValue(getRawValue());
+        }
         else
         {
             // printf("Calling callbacks...\n");
-            doReadCallbacks();
+            readBackend();
         }
     }
 };
 
+/**
+ * @brief Write-combining guard for a register and its bitfields.
+ *
+ * The base register is read once when the first transaction is opened. Any
+ * number of writes to the register or its bitfields then only update the
+ * shadow value, and a single write is issued when the outermost transaction
+ * is committed or goes out of scope.
+ *
+ * @code
+ *     {
+ *         RegisterTransaction txn(NVM.SoftwareArbitration.r32);
+ *         NVM.SoftwareArbitration.bits.ReqClr0 = 1;
+ *         NVM.SoftwareArbitration.bits.ReqClr1 = 1;
+ *     } // One MMIO write here.
+ * @endcode
+ */
+class RegisterTransaction
+{
+public:
+    RegisterTransaction(CXXRegisterBase& reg)
+    {
+        mBase = reg.getBaseRegister();
+        mOpen = true;
+
+        if(0 == mBase->mTransactionDepth)
+        {
+            // Snapshot the current hardware value.
+            mBase->mTransactionDirty = false;
+            mBase->doRelatedReadsBase(mBase);
+        }
+        mBase->mTransactionDepth++;
+    }
+
+    ~RegisterTransaction()
+    {
+        commit();
+    }
+
+    /**
+     * @brief Close the transaction. When this is the outermost transaction and
+     *        the shadow value was modified, the combined value is written out.
+     */
+    void commit(void)
+    {
+        if(!mOpen)
+        {
+            return;
+        }
+        mOpen = false;
+
+        if(0 == --mBase->mTransactionDepth && mBase->mTransactionDirty)
+        {
+            mBase->mTransactionDirty = false;
+            mBase->setTempValue(mBase->getRawValue());
+            mBase->writeBackend();
+        }
+    }
+
+private:
+    CXXRegisterBase* mBase;
+    bool mOpen;
+
+    // Not copyable.
+    RegisterTransaction(const RegisterTransaction&);
+    RegisterTransaction& operator=(const RegisterTransaction&);
+};
+
 template<typename T, unsigned int OFFSET, unsigned int WIDTH> class CXXRegister : public CXXRegisterBase
 {
 private:
@@ -220,12 +591,14 @@ private:
     std::vector< std::pair<callback_t, void*> > mReadCallback;
     std::vector< std::pair<callback_t, void*> > mWriteCallback;
 
-    T mValue;
-    T mTempValue;
-
     virtual void doWriteCallbacks(void)
     {
         T val = mTempValue;
+        if(mMMIOBase)
+        {
+            storeMMIO(val);
+        }
+
         // call callbacks
         typename std::vector<std::pair<callback_t, void*>>::iterator it;
         for(it = mWriteCallback.begin(); it != mWriteCallback.end(); it++)
@@ -243,7 +616,7 @@ private:
     virtual void doReadCallbacks(void)
     {
         // call callbacks
-        T val = mValue;
+        T val = mMMIOBase ? loadMMIO() : mValue;
         typename std::vector<std::pair<callback_t, void*>>::iterator it;
         for(it = mReadCallback.begin(); it != mReadCallback.end(); it++)
         {
@@ -262,7 +635,14 @@ private:
     {
         // printf("doWrite on %p with %x.\n", this, val);
         mTempValue = val;
-        doWriteCallbacks();
+        if(!mBaseRegister && mTransactionDepth)
+        {
+            // Direct write to a base register inside of a transaction.
+            mValue = val;
+            mTransactionDirty = true;
+            return;
+        }
+        writeBackend();
         doRelatedWrites();
     }
 
@@ -274,34 +654,9 @@ private:
         return mTempValue;
     }
 
-    virtual unsigned int getRawValue(void)
-    {
-        // printf("Getting raw: 0x%x\n", (mValue << mBitPosition) & mMask);
-        return (mValue << mBitPosition) & mMask;
-    }
-
-    virtual void setRawValue(unsigned int newVal)
-    {
-        // printf("Setting raw: 0x%x\n", (newVal & mMask) >> mBitPosition);
-        mValue = (newVal & mMask) >> mBitPosition;
-    }
-
-    virtual unsigned int getTempValue(void)
-    {
-        // printf("Getting temp: 0x%x\n", (mTempValue << mBitPosition) & mMask);
-        return (mTempValue << mBitPosition) & mMask;
-    }
-
-    virtual void setTempValue(unsigned int newVal)
-    {
-        // printf("Setting temp: 0x%x (%x)\n", (newVal & mMask) >> mBitPosition, newVal);
-        mTempValue = (newVal & mMask) >> mBitPosition;
-    }
-
 public:
     CXXRegister() : CXXRegisterBase(OFFSET, WIDTH)
     {
-        mValue = 0;
     }
 
     CXXRegister(T val) : CXXRegisterBase(OFFSET, WIDTH)
@@ -313,11 +668,29 @@ public:
     void installReadCallback(callback_t callback, void* args)
     {
         mReadCallback.push_back( std::make_pair(callback, args) );
+        setHasReadCallbacks();
+        mCacheValid = false;
     }
 
     void installWriteCallback(callback_t callback, void* args)
     {
         mWriteCallback.push_back( std::make_pair(callback, args) );
+        mHasWriteCallbacks = true;
+    }
+
+    /**
+     * @brief Bind the register directly to memory mapped I/O at
+     *        base + component offset.
+     *
+     * Unlike a read_from_ram/write_to_ram callback pair, accesses to a bound
+     * register without callbacks are a single load or store. Any callbacks
+     * installed later are chained after the MMIO access.
+     */
+    void setMMIOBase(void* base)
+    {
+        mMMIOBase = (volatile uint8_t*)base;
+        mMMIOWidth = sizeof(T);
+        mCacheValid = false;
     }
 
     virtual ~CXXRegister()
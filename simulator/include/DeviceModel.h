@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       DeviceModel.h
+///
+/// @project    
+///
+/// @brief      Software model of the BCM5719 register interface
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+#ifndef DEVICE_MODEL_H
+#define DEVICE_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/** @brief Size of each BAR image of the model. */
+#define DEVICE_MODEL_BAR_SIZE   (64 * 1024)
+
+/**
+ * @brief Allocate the BAR0/BAR2 images and the NVRAM contents of the model.
+ *
+ * @param nvram_path File with the initial NVRAM contents. If NULL or empty,
+ *                   the NVRAM starts out erased.
+ */
+bool DeviceModel_init(const char *nvram_path);
+
+/** @brief Memory backing the specified BAR of the model. */
+uint8_t *DeviceModel_getBAR(unsigned int bar);
+
+/**
+ * @brief Attach the model to the register blocks, once they are bound to the
+ *        BAR images, and set the reset values of the modeled registers.
+ */
+void DeviceModel_bind(void);
+
+/** @brief Current NVRAM contents of the model. */
+uint8_t *DeviceModel_getNVRAM(size_t *size);
+
+/** @brief Apply a single access to the model. Used as the CXXRegisterBase MMIO backend. */
+uint32_t DeviceModel_access(const char *name, volatile uint8_t *addr, uint32_t value, bool write);
+
+#endif /* DEVICE_MODEL_H */
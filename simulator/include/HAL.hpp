@@ -47,8 +47,33 @@
 
 #include <bcm5719_DEVICE.h>
 #include <bcm5719_APE.h>
+#include <MMIOTrace.h>
+#include <DeviceModel.h>
+#include <APELoader.h>
+
+#include <string>
+#include <vector>
 
 bool is_supported(uint16_t vendor_id, uint16_t device_id);
+
+/**
+ * @brief Find all supported devices attached to the system.
+ *
+ * @param wanted_function PCI function to match. Every function of a BCM5719
+ *                        shares the same NVRAM, so function 0 selects one
+ *                        entry per physical NIC.
+ * @returns The sorted sysfs paths, suitable for initHAL().
+ */
+std::vector<std::string> locateDevices(int wanted_function = 0);
+
+/**
+ * @brief Map the register blocks of a device.
+ *
+ * @param pci_path sysfs path of the PCI function, or NULL to locate one.
+ *                 "replay://TRACE" serves register accesses from a trace
+ *                 recorded with MMIOTrace_start() and "model://[NVRAM]"
+ *                 uses the in-process software model of the device.
+ */
 bool initHAL(const char* pci_path, int wanted_function = 0);
 
 #endif /* HAL_H */
\ No newline at end of file
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @file       MMIOTrace.h
+///
+/// @project    
+///
+/// @brief      Binary MMIO trace recorder
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// @copyright Copyright (c) 2020, Evan Lojewski
+/// @cond
+///
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+/// 1. Redistributions of source code must retain the above copyright notice,
+/// this list of conditions and the following disclaimer.
+/// 2. Redistributions in binary form must reproduce the above copyright notice,
+/// this list of conditions and the following disclaimer in the documentation
+/// and/or other materials provided with the distribution.
+/// 3. Neither the name of the copyright holder nor the
+/// names of its contributors may be used to endorse or promote products
+/// derived from this software without specific prior written permission.
+///
+////////////////////////////////////////////////////////////////////////////////
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+/// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+/// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+/// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+/// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+/// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+/// @endcond
+////////////////////////////////////////////////////////////////////////////////
+#ifndef MMIO_TRACE_H
+#define MMIO_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MMIO_TRACE_MAGIC        "BCMTRACE"
+#define MMIO_TRACE_VERSION      1
+
+/** @brief Entry types. */
+#define MMIO_TRACE_READ         0
+#define MMIO_TRACE_WRITE        1
+/** @brief Register name definition, followed by value bytes of name. */
+#define MMIO_TRACE_NAME         2
+
+/** @brief BAR number used for accesses outside of any registered BAR. */
+#define MMIO_TRACE_BAR_UNKNOWN  0xFF
+
+/** @brief Name id used for accesses without a register, e.g. SHM.write(). */
+#define MMIO_TRACE_NO_NAME      0
+
+typedef struct
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t entry_size;
+} mmio_trace_header_t;
+
+typedef struct
+{
+    /** @brief Nanoseconds since the trace was started. */
+    uint64_t timestamp;
+    /** @brief Offset into the BAR. */
+    uint32_t offset;
+    /** @brief Value read or written, or the name length for MMIO_TRACE_NAME. */
+    uint32_t value;
+    /** @brief Register name id. */
+    uint16_t name;
+    uint8_t  bar;
+    uint8_t  type;
+    uint32_t reserved;
+} mmio_trace_entry_t;
+
+/**
+ * @brief Start recording all MMIO accesses to the specified file.
+ *
+ * Accesses are stored in a preallocated ring buffer and written out by a
+ * background thread. The trace is stopped automatically at exit.
+ */
+bool MMIOTrace_start(const char *path);
+
+/** @brief Flush all pending entries, close the file and print a summary. */
+void MMIOTrace_stop(void);
+
+/** @brief Register a mapped BAR so addresses can be recorded as BAR offsets. */
+void MMIOTrace_setBAR(unsigned int bar, volatile uint8_t *base, size_t size);
+
+/** @brief Record a single access. Used as the CXXRegisterBase MMIO hook. */
+uint32_t MMIOTrace_record(const char *name, volatile uint8_t *addr, uint32_t value, bool write);
+
+/**
+ * @brief Load a trace recorded with MMIOTrace_start() for replay.
+ *
+ * Memory backed BARs are allocated for each BAR in the trace. Once
+ * replay is active, reads from these BARs return the values recorded
+ * for the same BAR offset, in order. After the recorded reads of an
+ * offset run out, the last value is returned. Offsets with no recorded
+ * reads return the last value written. Writes are compared against the
+ * recorded writes. Any difference is reported by MMIOReplay_close(),
+ * which also runs at exit.
+ */
+bool MMIOReplay_open(const char *path);
+
+/** @brief Memory backing the specified BAR during replay. */
+uint8_t *MMIOReplay_getBAR(unsigned int bar);
+
+/** @brief Print the replay summary and release the trace. */
+void MMIOReplay_close(void);
+
+/** @brief Replay a single access. Used as the CXXRegisterBase MMIO backend. */
+uint32_t MMIOReplay_access(const char *name, volatile uint8_t *addr, uint32_t value, bool write);
+
+#endif /* MMIO_TRACE_H */
@@ -0,0 +1,91 @@
+#include <bcm5719_NVM.h>
+#include <chrono>
+#include <stdio.h>
+
+#define ITERATIONS  (10 * 1000 * 1000)
+
+static uint32_t gMMIO[0x40];
+
+static uint32_t read_from_ram(uint32_t val, uint32_t offset, void *args)
+{
+    uint8_t *base = (uint8_t *)args;
+    base += offset;
+
+    CXX_REGISTER_BARRIER();
+    return *(volatile uint32_t *)base;
+}
+
+static uint32_t write_to_ram(uint32_t val, uint32_t offset, void *args)
+{
+    uint8_t *base = (uint8_t *)args;
+    base += offset;
+
+    CXX_REGISTER_BARRIER();
+    *(volatile uint32_t *)base = val;
+    CXX_REGISTER_BARRIER();
+    return val;
+}
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double elapsed_ns(bench_clock::time_point start)
+{
+    std::chrono::duration<double, std::nano> ns = bench_clock::now() - start;
+    return ns.count() / ITERATIONS;
+}
+
+static void run(const char *name, NVM_t &nvm)
+{
+    bench_clock::time_point start;
+    uint32_t sum = 0;
+
+    // NVRam_waitDone style polling of a single bit.
+    start = bench_clock::now();
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        sum += nvm.Command.bits.Done;
+    }
+    double bitRead = elapsed_ns(start);
+
+    start = bench_clock::now();
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        sum += nvm.Read.r32;
+    }
+    double wordRead = elapsed_ns(start);
+
+    start = bench_clock::now();
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        nvm.Write.r32 = i;
+    }
+    double wordWrite = elapsed_ns(start);
+
+    printf("%-10s bits read: %6.2f ns  r32 read: %6.2f ns  r32 write: %6.2f ns  (%x)\n",
+           name, bitRead, wordRead, wordWrite, sum & 0xF);
+}
+
+int main(int argc, char const *argv[])
+{
+    NVM_t callbacks;
+    callbacks.Command.r32.installReadCallback(read_from_ram, gMMIO);
+    callbacks.Command.r32.installWriteCallback(write_to_ram, gMMIO);
+    callbacks.Read.r32.installReadCallback(read_from_ram, gMMIO);
+    callbacks.Read.r32.installWriteCallback(write_to_ram, gMMIO);
+    callbacks.Write.r32.installReadCallback(read_from_ram, gMMIO);
+    callbacks.Write.r32.installWriteCallback(write_to_ram, gMMIO);
+
+    NVM_t direct;
+    direct.Command.r32.setMMIOBase(gMMIO);
+    direct.Read.r32.setMMIOBase(gMMIO);
+    direct.Write.r32.setMMIOBase(gMMIO);
+
+    gMMIO[0] = NVM_COMMAND_DONE_MASK;
+    gMMIO[4] = 0x12345678;
+
+    printf("Per-access overhead, %d iterations\n", ITERATIONS);
+    run("callbacks", callbacks);
+    run("mmio", direct);
+
+    return 0;
+}
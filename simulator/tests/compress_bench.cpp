@@ -0,0 +1,158 @@
+#include <Compress.h>
+#include <chrono>
+#include <elfio/elfio.hpp>
+#include <fstream>
+#include <iterator>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace ELFIO;
+
+#define MIN_BENCH_SECONDS   (0.2)
+
+typedef std::vector<uint8_t> section_t;
+
+// Allocated sections of an APE ELF, or the whole file for anything else.
+static bool load_sections(const char *path, std::vector<section_t> &sections)
+{
+    elfio reader;
+    if (reader.load(path))
+    {
+        for (int i = 0; i < reader.sections.size(); i++)
+        {
+            section *psec = reader.sections[i];
+            if ((psec->get_flags() & SHF_ALLOC) && psec->get_data() && psec->get_size())
+            {
+                const uint8_t *data = (const uint8_t *)psec->get_data();
+                sections.push_back(section_t(data, data + psec->get_size()));
+            }
+        }
+        return true;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    sections.push_back(section_t(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+    return !sections.back().empty();
+}
+
+typedef std::chrono::steady_clock bench_clock;
+
+static void run(const char *name, const compress_options_t *options, const std::vector<section_t> &sections)
+{
+    size_t in = 0;
+    size_t out = 0;
+    int iterations = 0;
+    bool verified = true;
+
+    bench_clock::time_point start = bench_clock::now();
+    std::chrono::duration<double> seconds;
+    do
+    {
+        for (size_t i = 0; i < sections.size(); i++)
+        {
+            const section_t &section = sections[i];
+            std::vector<uint8_t> compressed(section.size() * 2 + 16);
+            int32_t size = compress_ex(compressed.data(), compressed.size(), section.data(), section.size(), options);
+
+            if (!iterations)
+            {
+                std::vector<uint8_t> decompressed(section.size());
+                int32_t length = decompress(decompressed.data(), decompressed.size(), compressed.data(), size);
+                verified &= (length == (int32_t)section.size()) && (decompressed == section);
+
+                in += section.size();
+                out += size;
+            }
+        }
+        iterations++;
+        seconds = bench_clock::now() - start;
+    } while (seconds.count() < MIN_BENCH_SECONDS);
+
+    double mb = (double)in * iterations / (1024 * 1024);
+    printf("%-12s %8zu -> %8zu bytes (%5.1f%%)  %8.2f MB/s  %s\n", name, in, out,
+           100.0 * out / in, mb / seconds.count(), verified ? "ok" : "MISMATCH");
+}
+
+typedef int32_t (*decompress_function_t)(uint8_t *, int32_t, const uint8_t *, int32_t);
+
+static void run_decode(const char *name, decompress_function_t decode, const std::vector<section_t> &sections)
+{
+    std::vector<section_t> compressed;
+    size_t out = 0;
+    int iterations = 0;
+    bool verified = true;
+
+    for (size_t i = 0; i < sections.size(); i++)
+    {
+        section_t buffer(sections[i].size() * 2 + 16);
+        buffer.resize(compress(buffer.data(), buffer.size(), sections[i].data(), sections[i].size()));
+        compressed.push_back(buffer);
+    }
+
+    bench_clock::time_point start = bench_clock::now();
+    std::chrono::duration<double> seconds;
+    do
+    {
+        for (size_t i = 0; i < sections.size(); i++)
+        {
+            std::vector<uint8_t> decompressed(sections[i].size());
+            int32_t length = decode(decompressed.data(), decompressed.size(), compressed[i].data(), compressed[i].size());
+
+            if (!iterations)
+            {
+                verified &= (length == (int32_t)sections[i].size()) && (decompressed == sections[i]);
+                out += length;
+            }
+        }
+        iterations++;
+        seconds = bench_clock::now() - start;
+    } while (seconds.count() < MIN_BENCH_SECONDS);
+
+    double mb = (double)out * iterations / (1024 * 1024);
+    printf("%-12s %8zu bytes  %8.2f MB/s  %s\n", name, out, mb / seconds.count(), verified ? "ok" : "MISMATCH");
+}
+
+int main(int argc, char const *argv[])
+{
+    std::vector<section_t> sections;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <ape.elf|file>...\n", argv[0]);
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!load_sections(argv[i], sections))
+        {
+            fprintf(stderr, "Unable to read %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    run("tree", NULL, sections);
+
+    static const uint32_t depths[] = { 1, 4, 16, 64, 256, 4096 };
+    for (size_t i = 0; i < sizeof(depths) / sizeof(depths[0]); i++)
+    {
+        compress_options_t options = { COMPRESS_HASH_CHAIN, depths[i], 0 };
+        std::string name = "chain/" + std::to_string(depths[i]);
+        run(name.c_str(), &options, sections);
+    }
+
+    compress_options_t best = { COMPRESS_HASH_CHAIN, 0, 0, COMPRESS_OPTIMAL };
+    run("optimal", &best, sections);
+
+    printf("\nDecompression\n");
+    run_decode("decompress", decompress, sections);
+    run_decode("fast", decompress_fast, sections);
+
+    return 0;
+}
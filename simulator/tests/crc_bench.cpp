@@ -0,0 +1,64 @@
+#include <NVRam.h>
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+#define IMAGE_SIZE  (256 * 1024)
+#define ITERATIONS  (64)
+
+typedef uint32_t (*crc_function_t)(const uint8_t *, uint32_t, uint32_t);
+
+static uint32_t crc_bitwise(const uint8_t *data, uint32_t length, uint32_t crc)
+{
+    while (length--)
+    {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+        }
+    }
+    return crc;
+}
+
+typedef std::chrono::steady_clock bench_clock;
+
+static uint32_t run(const char *name, crc_function_t crc, const std::vector<uint8_t> &image)
+{
+    uint32_t result = 0;
+
+    bench_clock::time_point start = bench_clock::now();
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        result = crc(image.data(), image.size(), 0xffffffff);
+    }
+    std::chrono::duration<double> seconds = bench_clock::now() - start;
+
+    double mb = (double)image.size() * ITERATIONS / (1024 * 1024);
+    printf("%-10s %8.3f ms per image  %8.1f MB/s  (%08x)\n",
+           name, seconds.count() * 1000 / ITERATIONS, mb / seconds.count(), ~result);
+
+    return result;
+}
+
+int main(int argc, char const *argv[])
+{
+    std::vector<uint8_t> image(IMAGE_SIZE);
+    for (size_t i = 0; i < image.size(); i++)
+    {
+        image[i] = (i * 2654435761u) >> 13;
+    }
+
+    printf("CRC32 over a %d KB image, %d iterations\n", IMAGE_SIZE / 1024, ITERATIONS);
+    uint32_t expected = run("bitwise", crc_bitwise, image);
+    bool match = (expected == run("software", NVRam_crcSoftware, image));
+    match = (expected == run("dispatch", NVRam_crc, image)) && match;
+
+    if (!match)
+    {
+        printf("CRC mismatch.\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,559 @@
+#include "gtest/gtest.h"
+#include <bcm5719_NVM.h>
+#include <MMIOTrace.h>
+#include <HAL.hpp>
+#include <bcm5719_APE_PERI.h>
+#include <bcm5719_SHM.h>
+#include <NVRam.h>
+#include <APE.h>
+#include <APE_FILTERS.h>
+#include <Lock.h>
+#include <MII.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+static uint32_t gRegister;
+static uint32_t gReads;
+static uint32_t gWrites;
+
+static uint32_t read_register(uint32_t val, uint32_t offset, void *args)
+{
+    gReads++;
+    return gRegister;
+}
+
+static uint32_t write_register(uint32_t val, uint32_t offset, void *args)
+{
+    gWrites++;
+    gRegister = val;
+    return val;
+}
+
+static void reset_counters(uint32_t value)
+{
+    gRegister = value;
+    gReads = 0;
+    gWrites = 0;
+}
+
+static bool init_model(void)
+{
+    // The model can only be initialized once per process.
+    return DeviceModel_getNVRAM(NULL) || initHAL("model://");
+}
+
+namespace {
+
+TEST(RegisterTransaction, CombinesBitfieldWrites) {
+    RegNVMSoftwareArbitration_t reg;
+    reg.r32.installReadCallback(read_register, NULL);
+    reg.r32.installWriteCallback(write_register, NULL);
+    reset_counters(0);
+
+    {
+        RegisterTransaction txn(reg.r32);
+        reg.bits.ReqClr0 = 1;
+        reg.bits.ReqClr1 = 1;
+        reg.bits.ReqClr2 = 1;
+        reg.bits.ReqClr3 = 1;
+
+        EXPECT_EQ(gWrites, 0u);
+    }
+
+    EXPECT_EQ(gReads, 1u);
+    EXPECT_EQ(gWrites, 1u);
+    EXPECT_EQ(gRegister, 0xF0u);
+}
+
+TEST(RegisterTransaction, ReadsServedFromShadow) {
+    RegNVMSoftwareArbitration_t reg;
+    reg.r32.installReadCallback(read_register, NULL);
+    reg.r32.installWriteCallback(write_register, NULL);
+    reset_counters(0x100);
+
+    RegisterTransaction txn(reg.r32);
+    reg.bits.ReqSet2 = 1;
+    EXPECT_EQ((uint32_t)reg.bits.ReqSet2, 1u);
+    EXPECT_EQ((uint32_t)reg.bits.ArbWon0, 1u);
+    EXPECT_EQ((uint32_t)reg.r32, 0x104u);
+    EXPECT_EQ(gReads, 1u);
+
+    txn.commit();
+    EXPECT_EQ(gWrites, 1u);
+    EXPECT_EQ(gRegister, 0x104u);
+
+    // Committing twice has no effect.
+    txn.commit();
+    EXPECT_EQ(gWrites, 1u);
+}
+
+TEST(RegisterTransaction, NestedCommitsOnce) {
+    RegNVMSoftwareArbitration_t reg;
+    reg.r32.installReadCallback(read_register, NULL);
+    reg.r32.installWriteCallback(write_register, NULL);
+    reset_counters(0);
+
+    {
+        RegisterTransaction outer(reg.r32);
+        {
+            RegisterTransaction inner(reg.bits.ReqSet0);
+            reg.bits.ReqSet0 = 1;
+        }
+        EXPECT_EQ(gWrites, 0u);
+        reg.r32 = reg.r32 | 0x2;
+    }
+
+    EXPECT_EQ(gReads, 1u);
+    EXPECT_EQ(gWrites, 1u);
+    EXPECT_EQ(gRegister, 0x3u);
+}
+
+TEST(RegisterTransaction, NoWriteWhenUnmodified) {
+    RegNVMSoftwareArbitration_t reg;
+    reg.r32.installReadCallback(read_register, NULL);
+    reg.r32.installWriteCallback(write_register, NULL);
+    reset_counters(0x55);
+
+    {
+        RegisterTransaction txn(reg.r32);
+        EXPECT_EQ((uint32_t)reg.r32, 0x55u);
+    }
+
+    EXPECT_EQ(gReads, 1u);
+    EXPECT_EQ(gWrites, 0u);
+}
+
+TEST(CXXRegister, MMIOBinding) {
+    uint32_t mmio[2] = { 0, 0x100 };
+    RegNVMSoftwareArbitration_t reg;
+    reg.r32.setComponentOffset(4);
+    reg.r32.setMMIOBase(mmio);
+
+    EXPECT_EQ((uint32_t)reg.bits.ArbWon0, 1u);
+    reg.bits.ReqSet2 = 1;
+    EXPECT_EQ(mmio[1], 0x104u);
+    reg.r32 = 0x55;
+    EXPECT_EQ(mmio[1], 0x55u);
+    EXPECT_EQ(mmio[0], 0u);
+
+    // Callbacks installed on top of a binding see the MMIO value first.
+    reg.r32.installReadCallback(read_register, NULL);
+    reset_counters(0xAA);
+    EXPECT_EQ((uint32_t)reg.r32, 0xAAu);
+    EXPECT_EQ(gReads, 1u);
+}
+
+TEST(CXXRegister, ReadOnceCache) {
+    RegNVMSoftwareArbitration_t reg;
+    reg.r32.installReadCallback(read_register, NULL);
+    reg.r32.installWriteCallback(write_register, NULL);
+    reg.r32.setCachePolicy(CXXRegisterBase::CACHE_READ_ONCE);
+    reset_counters(0x100);
+
+    EXPECT_EQ((uint32_t)reg.r32, 0x100u);
+    EXPECT_EQ((uint32_t)reg.bits.ArbWon0, 1u);
+    EXPECT_EQ((uint32_t)reg.r32, 0x100u);
+    EXPECT_EQ(gReads, 1u);
+
+    // Writes invalidate the cached value.
+    reg.r32 = 0x1;
+    EXPECT_EQ((uint32_t)reg.r32, 0x1u);
+    EXPECT_EQ((uint32_t)reg.r32, 0x1u);
+    EXPECT_EQ(gReads, 2u);
+}
+
+TEST(CXXRegister, WriteThroughCache) {
+    RegNVMSoftwareArbitration_t reg;
+    reg.r32.installReadCallback(read_register, NULL);
+    reg.r32.installWriteCallback(write_register, NULL);
+    reg.r32.setCachePolicy(CXXRegisterBase::CACHE_WRITE_THROUGH);
+    reset_counters(0x100);
+
+    reg.bits.ReqSet1 = 1;
+    EXPECT_EQ(gWrites, 1u);
+    EXPECT_EQ(gRegister, 0x2u);
+    EXPECT_EQ((uint32_t)reg.r32, 0x2u);
+    EXPECT_EQ((uint32_t)reg.bits.ReqSet1, 1u);
+    EXPECT_EQ(gReads, 0u);
+
+    reg.r32.invalidateCache();
+    gRegister = 0x200;
+    EXPECT_EQ((uint32_t)reg.bits.ArbWon1, 1u);
+    EXPECT_EQ(gReads, 1u);
+}
+
+TEST(MMIOTrace, RecordsAccesses) {
+    uint32_t mmio[4] = { 0, 0, 0, 0 };
+    const char *path = "mmio_trace_test.bin";
+    RegNVMSoftwareArbitration_t reg;
+    reg.r32.setComponentOffset(8);
+    reg.r32.setMMIOBase(mmio);
+
+    MMIOTrace_setBAR(0, (uint8_t *)mmio, sizeof(mmio));
+    ASSERT_TRUE(MMIOTrace_start(path));
+    reg.r32 = 0x12;
+    EXPECT_EQ((uint32_t)reg.r32, 0x12u);
+    MMIOTrace_stop();
+    MMIOTrace_setBAR(0, NULL, 0);
+
+    FILE *file = fopen(path, "rb");
+    ASSERT_TRUE(file != NULL);
+
+    mmio_trace_header_t header;
+    mmio_trace_entry_t entry;
+    char name[32] = { 0 };
+    ASSERT_EQ(fread(&header, sizeof(header), 1, file), 1u);
+    EXPECT_EQ(header.entry_size, sizeof(entry));
+
+    // Name definition, then the write and the read.
+    ASSERT_EQ(fread(&entry, sizeof(entry), 1, file), 1u);
+    EXPECT_EQ(entry.type, MMIO_TRACE_NAME);
+    ASSERT_EQ(fread(name, entry.value, 1, file), 1u);
+    EXPECT_STREQ(name, "SoftwareArbitration");
+
+    ASSERT_EQ(fread(&entry, sizeof(entry), 1, file), 1u);
+    EXPECT_EQ(entry.type, MMIO_TRACE_WRITE);
+    EXPECT_EQ(entry.bar, 0u);
+    EXPECT_EQ(entry.offset, 8u);
+    EXPECT_EQ(entry.value, 0x12u);
+
+    ASSERT_EQ(fread(&entry, sizeof(entry), 1, file), 1u);
+    EXPECT_EQ(entry.type, MMIO_TRACE_READ);
+    EXPECT_EQ(fread(&entry, sizeof(entry), 1, file), 0u);
+
+    fclose(file);
+    remove(path);
+}
+
+TEST(MMIOTrace, Replay) {
+    uint32_t mmio[4] = { 0, 0, 0, 0 };
+    const char *path = "mmio_replay_test.bin";
+    RegNVMSoftwareArbitration_t reg;
+    reg.r32.setComponentOffset(4);
+    reg.r32.setMMIOBase(mmio);
+
+    MMIOTrace_setBAR(0, (uint8_t *)mmio, sizeof(mmio));
+    ASSERT_TRUE(MMIOTrace_start(path));
+    mmio[1] = 0x100;
+    EXPECT_EQ((uint32_t)reg.r32, 0x100u);
+    mmio[1] = 0x200;
+    EXPECT_EQ((uint32_t)reg.r32, 0x200u);
+    reg.r32 = 0x5;
+    MMIOTrace_stop();
+    MMIOTrace_setBAR(0, NULL, 0);
+
+    ASSERT_TRUE(MMIOReplay_open(path));
+    reg.r32.setMMIOBase(MMIOReplay_getBAR(0));
+    EXPECT_EQ((uint32_t)reg.r32, 0x100u);
+    EXPECT_EQ((uint32_t)reg.r32, 0x200u);
+    // Reads past the end of the trace return the last value.
+    EXPECT_EQ((uint32_t)reg.r32, 0x200u);
+    reg.r32 = 0x5;
+    MMIOReplay_close();
+
+    remove(path);
+}
+
+TEST(DeviceModel, HostLibraries) {
+    ASSERT_TRUE(init_model());
+    EXPECT_EQ((uint32_t)DEVICE.ChipId.r32, 0x05719001u);
+    EXPECT_EQ(DEVICE.ChipId.r32.getCachePolicy(), CXXRegisterBase::CACHE_READ_ONCE);
+    EXPECT_EQ(DEVICE.PciVendorDeviceId.r32.getCachePolicy(), CXXRegisterBase::CACHE_VOLATILE);
+
+    size_t size;
+    uint8_t *nvram = DeviceModel_getNVRAM(&size);
+    ASSERT_TRUE(nvram != NULL);
+
+    NVRam_acquireLock();
+    EXPECT_EQ((uint32_t)NVM.SoftwareArbitration.bits.ArbWon2, 1u);
+    NVRam_enable();
+    NVRam_enableWrites();
+    NVRam_writeWord(0x10, 0x12345678);
+    EXPECT_EQ(nvram[0x10], 0x78u);
+    EXPECT_EQ(NVRam_readWord(0x10), 0x12345678u);
+    EXPECT_EQ(NVRam_readWord(0x14), 0xFFFFFFFFu);
+    NVRam_releaseLock();
+    EXPECT_EQ((uint32_t)NVM.SoftwareArbitration.bits.ArbWon2, 0u);
+
+    MII_writeRegister(1, (mii_reg_t)0x10, 0xBEEF);
+    EXPECT_EQ(MII_readRegister(1, (mii_reg_t)0x10), 0xBEEFu);
+
+    APE_aquireLock();
+    EXPECT_NE((uint32_t)APE_PERI.PerLockGrantPhy0.r32, 0u);
+    APE_releaseLock();
+    EXPECT_EQ((uint32_t)APE_PERI.PerLockGrantPhy0.r32, 0u);
+
+    SHM.LoaderArg0.r32 = 0x1000;
+    SHM.LoaderArg1.r32 = 0xCAFE;
+    SHM.LoaderCommand.bits.Command = SHM_LOADER_COMMAND_COMMAND_WRITE_MEM;
+    EXPECT_EQ((uint32_t)SHM.LoaderCommand.bits.Command, 0u);
+    SHM.LoaderArg0.r32 = 0x1000;
+    SHM.LoaderCommand.bits.Command = SHM_LOADER_COMMAND_COMMAND_READ_MEM;
+    EXPECT_EQ((uint32_t)SHM.LoaderArg0.r32, 0xCAFEu);
+}
+
+TEST(Lock, TimeoutAndStats) {
+    ASSERT_TRUE(init_model());
+    Lock_resetStats();
+
+    // Another agent (requester 0) holds the NVM arbitration.
+    RegNVMSoftwareArbitration_t other;
+    other.r32 = 0;
+    other.bits.ReqSet0 = 1;
+    NVM.SoftwareArbitration = other;
+
+    EXPECT_FALSE(Lock_acquire(LOCK_NVM, 20));
+    const LockStats_t *stats = Lock_getStats(LOCK_NVM);
+    EXPECT_EQ(stats->timeouts, 1u);
+    EXPECT_EQ(stats->maxSpins, 20u);
+    EXPECT_EQ(stats->acquisitions, 0u);
+
+    // The timed out request was withdrawn, so releasing the other agent
+    // does not hand the lock to us.
+    other.r32 = 0;
+    other.bits.ReqClr0 = 1;
+    NVM.SoftwareArbitration = other;
+    EXPECT_EQ((uint32_t)NVM.SoftwareArbitration.bits.ArbWon2, 0u);
+
+    EXPECT_TRUE(NVRam_acquireLock());
+    NVRam_releaseLock();
+    EXPECT_EQ(stats->acquisitions, 1u);
+    EXPECT_EQ(stats->contended, 1u);
+
+    EXPECT_TRUE(Lock_acquire(LOCK_GRC_MUTEX, 20));
+    EXPECT_EQ((uint32_t)DEVICE.MutexGrant.r32, 1u << 4);
+    Lock_release(LOCK_GRC_MUTEX);
+    EXPECT_EQ((uint32_t)DEVICE.MutexGrant.r32, 0u);
+    EXPECT_EQ(Lock_getStats(LOCK_GRC_MUTEX)->acquisitions, 1u);
+}
+
+TEST(NVRam, PageBurstWrite) {
+    ASSERT_TRUE(init_model());
+
+    size_t size;
+    uint8_t *nvram = DeviceModel_getNVRAM(&size);
+    ASSERT_TRUE(nvram != NULL);
+
+    // Three pages starting mid-page, matching the current contents.
+    uint32_t address = NVRAM_PAGE_SIZE - 8;
+    uint32_t words[(NVRAM_PAGE_SIZE * 2 + 8) / 4];
+    size_t numWords = sizeof(words) / 4;
+    memcpy(words, &nvram[address], sizeof(words));
+
+    NVRamPageStatus_t status[3];
+    ASSERT_EQ(NVRAM_PAGE_COUNT(address, numWords), 3u);
+
+    NVRam_acquireLock();
+    NVRam_enable();
+    NVRam_enableWrites();
+    EXPECT_EQ(NVRam_writePages(address, words, numWords, status), 0u);
+    EXPECT_EQ(status[0], NVRAM_PAGE_UNCHANGED);
+    EXPECT_EQ(status[1], NVRAM_PAGE_UNCHANGED);
+    EXPECT_EQ(status[2], NVRAM_PAGE_UNCHANGED);
+
+    // Change the last word of the middle page only.
+    words[(NVRAM_PAGE_SIZE + 8) / 4 - 1] ^= 0xA5A5A5A5;
+    EXPECT_EQ(NVRam_writePages(address, words, numWords, status), 1u);
+    EXPECT_EQ(status[0], NVRAM_PAGE_UNCHANGED);
+    EXPECT_EQ(status[1], NVRAM_PAGE_WRITTEN);
+    EXPECT_EQ(status[2], NVRAM_PAGE_UNCHANGED);
+    NVRam_releaseLock();
+
+    EXPECT_EQ(memcmp(&nvram[address], words, sizeof(words)), 0);
+}
+
+TEST(NVRam, PageDiffWrite) {
+    ASSERT_TRUE(init_model());
+
+    size_t size;
+    uint8_t *nvram = DeviceModel_getNVRAM(&size);
+    ASSERT_TRUE(nvram != NULL);
+
+    uint32_t before[(NVRAM_PAGE_SIZE * 3) / 4];
+    uint32_t after[(NVRAM_PAGE_SIZE * 3) / 4];
+    size_t numWords = sizeof(before) / 4;
+    memcpy(before, nvram, sizeof(before));
+    memcpy(after, before, sizeof(after));
+    after[numWords - 1] ^= 0x5A5A5A5A;
+
+    NVRamPageStatus_t status[3];
+
+    NVRam_acquireLock();
+    NVRam_enable();
+    NVRam_enableWrites();
+    EXPECT_EQ(NVRam_writeChanged(0, before, after, numWords, status), 1u);
+    NVRam_releaseLock();
+
+    EXPECT_EQ(status[0], NVRAM_PAGE_UNCHANGED);
+    EXPECT_EQ(status[1], NVRAM_PAGE_UNCHANGED);
+    EXPECT_EQ(status[2], NVRAM_PAGE_WRITTEN);
+    EXPECT_EQ(memcmp(nvram, after, sizeof(after)), 0);
+}
+
+TEST(NVRam, StreamingCRC) {
+    ASSERT_TRUE(init_model());
+
+    size_t size;
+    uint8_t *nvram = DeviceModel_getNVRAM(&size);
+    ASSERT_TRUE(nvram != NULL);
+
+    // A small ring is enough to CRC a region much larger than it.
+    uint32_t ring[64];
+    uint32_t crc = 0xffffffff;
+
+    NVRam_acquireLock();
+    NVRam_enable();
+    EXPECT_TRUE(NVRam_readStream(0x100, 1000, ring, 64, 16, NVRam_crcCallback, &crc));
+
+    // Chunks that would run past the end of the ring are refused.
+    uint32_t unused = 0xffffffff;
+    EXPECT_FALSE(NVRam_readStream(0x100, 1000, ring, 64, 24, NVRam_crcCallback, &unused));
+    EXPECT_FALSE(NVRam_readStream(0x100, 1000, ring, 64, 128, NVRam_crcCallback, &unused));
+    EXPECT_FALSE(NVRam_readStream(0x100, 1000, ring, 64, 0, NVRam_crcCallback, &unused));
+    NVRam_releaseLock();
+
+    EXPECT_EQ(crc, NVRam_crc(&nvram[0x100], 4000, 0xffffffff));
+    EXPECT_EQ(memcmp(&ring[(1000 - 8) % 64], &nvram[0x100 + 4000 - 32], 32), 0);
+}
+
+TEST(NVRam, HostCache) {
+    ASSERT_TRUE(init_model());
+
+    uint32_t first[200];
+    uint32_t second[200];
+
+    NVRam_acquireLock();
+    NVRam_enable();
+    NVRam_enableWrites();
+    NVRam_enableCache(true);
+
+    NVRam_read(0x1000, first, 200);
+    uint32_t pagesRead = NVRam_getCacheStats()->pagesRead;
+    NVRam_read(0x1000, second, 200);
+    EXPECT_EQ(NVRam_getCacheStats()->pagesRead, pagesRead);
+    EXPECT_EQ(memcmp(first, second, sizeof(first)), 0);
+
+    // Writes drop the cached page, so the new value is read back.
+    NVRam_writeWord(0x1010, ~first[4]);
+    EXPECT_EQ(NVRam_readWord(0x1010), ~first[4]);
+    EXPECT_GT(NVRam_getCacheStats()->pagesRead, pagesRead);
+
+    // Read-ahead stops at the last page of the flash.
+    NVRam_invalidateCache();
+    uint32_t lastPage = (NVRAM_SIZE - 1) / NVRAM_PAGE_SIZE;
+    pagesRead = NVRam_getCacheStats()->pagesRead;
+    for (uint32_t page = lastPage - 2; page <= lastPage; page++)
+    {
+        NVRam_read(page * NVRAM_PAGE_SIZE, first, 1);
+    }
+    EXPECT_EQ(NVRam_getCacheStats()->pagesRead - pagesRead, 3u);
+
+    NVRam_enableCache(false);
+    NVRam_releaseLock();
+}
+
+TEST(APELoader, BlockTransfers) {
+    ASSERT_TRUE(init_model());
+
+    uint32_t words[600];
+    for (unsigned int i = 0; i < 600; i++)
+    {
+        words[i] = i * 0x01010101;
+    }
+
+    // Larger than the SHM staging buffer, split over several commands.
+    APELoader_writeMem(0x10D800, words, 600);
+    EXPECT_EQ(APELoader_readWord(0x10D800 + 599 * 4), 599u * 0x01010101);
+
+    uint32_t readback[600] = { 0 };
+    APELoader_readMem(0x10D800, readback, 600);
+    EXPECT_EQ(0, memcmp(words, readback, sizeof(words)));
+
+    APELoader_memset(0x10D804, 0xA5A5A5A5, 2);
+    APELoader_readMem(0x10D800, readback, 4);
+    EXPECT_EQ(readback[0], 0u);
+    EXPECT_EQ(readback[1], 0xA5A5A5A5u);
+    EXPECT_EQ(readback[2], 0xA5A5A5A5u);
+    EXPECT_EQ(readback[3], 3u * 0x01010101);
+
+    // Register callbacks and block reads reach the same APE memory.
+    FILTERS.ElementPattern[1].r32 = 0x12345678;
+    APELoader_readMem(0xa0048080, readback, 2);
+    EXPECT_EQ(readback[1], 0x12345678u);
+}
+
+TEST(APELoader, CompressedUpload) {
+    ASSERT_TRUE(init_model());
+
+    // Compressible data, a zero filled region and incompressible data.
+    static uint32_t words[3 * 512];
+    for (unsigned int i = 0; i < 512; i++)
+    {
+        words[i] = 0xE12FFF1E + (i % 16);
+        words[512 + i] = 0;
+        words[1024 + i] = (i * 2654435761u) ^ (i << 7);
+    }
+
+    size_t sent = APELoader_writeCompressed(0x130000, words, 3 * 512);
+    EXPECT_LT(sent, sizeof(words) / 2);
+
+    static uint32_t readback[3 * 512];
+    APELoader_readMem(0x130000, readback, 3 * 512);
+    EXPECT_EQ(0, memcmp(words, readback, sizeof(words)));
+}
+
+TEST(APELoader, BlockCRC) {
+    ASSERT_TRUE(init_model());
+
+    uint32_t words[64];
+    for (unsigned int i = 0; i < 64; i++)
+    {
+        words[i] = i * 0x10204081;
+    }
+    APELoader_writeMem(0x140000, words, 64);
+
+    EXPECT_EQ(APELoader_crc(0x140000, sizeof(words)),
+              NVRam_crc((const uint8_t *)words, sizeof(words), 0xffffffff));
+    EXPECT_EQ(APELoader_crc(0x140001, 7),
+              NVRam_crc((const uint8_t *)words + 1, 7, 0xffffffff));
+}
+
+TEST(APELoader, CommandRing) {
+    ASSERT_TRUE(init_model());
+
+    // Start the loader so that it advertises the ring.
+    RegAPEMode_t mode;
+    mode.r32 = 0;
+    mode.bits.Reset = 1;
+    APE.Mode = mode;
+    ASSERT_TRUE(APELoader_initRing());
+
+    // More commands than ring entries.
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        APELoader_queueWrite(0x120000 + i * 4, i ^ 0x5A5A5A5A);
+    }
+
+    uint32_t values[300] = { 0 };
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        APELoader_queueRead(0x120000 + i * 4, &values[i]);
+    }
+    APELoader_flush();
+
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        EXPECT_EQ(values[i], i ^ 0x5A5A5A5A);
+    }
+
+    // Mailbox commands are ordered after queued commands.
+    APELoader_queueWrite(0x120000, 0x1234);
+    EXPECT_EQ(APELoader_readWord(0x120000), 0x1234u);
+
+    // Register writes are queued, register reads see them.
+    FILTERS.ElementConfig[0].r32 = 0x5678;
+    EXPECT_EQ((uint32_t)FILTERS.ElementConfig[0].r32, 0x5678u);
+}
+
+}  // namespace
@@ -46,6 +46,7 @@
 
 #include <MII.h>
 #include <APE.h>
+#include <Lock.h>
 #include <bcm5719_DEVICE.h>
 #include <bcm5719_GEN.h>
 #include <bcm5719_RXMBUF.h>
@@ -168,6 +169,10 @@ void early_init_hw(void)
     pcistate.bits.APEProgramSpaceWriteEnable = 1;
     DEVICE.PciState = pcistate;
 
+    // SHM is now writable, start a fresh boot timeline.
+    initBootTimeline();
+    reportStatus(STATUS_EARLY_INIT, 0);
+
     // Configure GPHY
     RegDEVICEGphyControlStatus_t gphystate = DEVICE.GphyControlStatus;
     gphystate.bits.GPHYIDDQ = 0;               // Power on GPHY
@@ -190,6 +195,8 @@ void early_init_hw(void)
     memset((void*)&RXMBUF, 0, REG_RXMBUF_SIZE);
     memset((void*)&TXMBUF, 0, REG_TXMBUF_SIZE);
     memset((void*)&SDBCACHE, 0, REG_SDBCACHE_SIZE);
+
+    reportStatus(STATUS_EARLY_INIT, 0xff);
 }
 
 
@@ -368,6 +375,7 @@ void init_gen(NVRAMContents_t* nvram)
 
 void load_nvm_config(NVRAMContents_t *nvram)
 {
+    reportStatus(STATUS_NVM_CONFIG, 0);
     // Load information from NVM, set various registers + mem
 
     // MAC Addr, serial number
@@ -384,6 +392,8 @@ void load_nvm_config(NVRAMContents_t *nvram)
     init_pci(nvram);
 
     init_gen(nvram);
+
+    reportStatus(STATUS_NVM_CONFIG, 0xff);
 }
 
 void init_hw(NVRAMContents_t *nvram)
@@ -472,14 +482,21 @@ void init_hw(NVRAMContents_t *nvram)
 
     reportStatus(STATUS_INIT_HW, 0xf0);
 
-    // Perform MII init.
-    APE_aquireLock();
-    init_mii_function0();
+    // Perform MII init. If the APE never grants the lock, leave the PHY
+    // alone rather than racing the APE for it.
+    if (APE_aquireLock())
+    {
+        init_mii_function0();
 
-    reportStatus(STATUS_INIT_HW, 0xfe);
+        reportStatus(STATUS_INIT_HW, 0xfe);
 
-    init_mii();
-    APE_releaseLock();
+        init_mii();
+        APE_releaseLock();
+    }
+    else
+    {
+        reportStatus(STATUS_INIT_HW, 0xfd);
+    }
 
 
     RegDEVICEBufferManagerMode_t bmm;
@@ -496,28 +513,25 @@ void init_hw(NVRAMContents_t *nvram)
 
     // Setup link-aware power mode.
     // The following must be performed while holding REG_MUTEX_{REQUEST,GRANT}; use bit 4.
-    DEVICE.MutexRequest.r32 |= (1 << 4);
-    while(0 == (DEVICE.MutexGrant.r32 & (1 << 4)))
+    // If the mutex is never granted, leave the power mode policy at its default.
+    if (Lock_acquire(LOCK_GRC_MUTEX, LOCK_TIMEOUT_SPINS))
     {
-        // Wait for grant.
+        // Set REG_LINK_AWARE_POWER_MODE_CLOCK_POLICY to MAC_CLOCK_SWITCH__6_25MHZ.
+        RegDEVICELinkAwarePowerModeClockPolicy_t lapmcp;
+        lapmcp.r32 = 0;
+        lapmcp.bits.MACClockSwitch = DEVICE_LINK_AWARE_POWER_MODE_CLOCK_POLICY_MAC_CLOCK_SWITCH_6_25MHZ;
+        DEVICE.LinkAwarePowerModeClockPolicy = lapmcp;
+        // Set REG_CPMU_CONTROL to zero or more of LINK_AWARE_POWER_MODE_ENABLE, LINK_IDLE_POWER_MODE_ENABLE, LINK_SPEED_POWER_MODE_ENABLE as desired (see NVM CfgFeature).
+        RegDEVICECpmuControl_t cpmu_control;
+        cpmu_control.r32 = 0;
+        cpmu_control.bits.LinkIdlePowerModeEnable  = GEN.GenCfgFeature.bits.LinkIdle;
+        cpmu_control.bits.LinkAwarePowerModeEnable = GEN.GenCfgFeature.bits.LinkAwarePowerMode;
+        cpmu_control.bits.LinkSpeedPowerModeEnable = GEN.GenCfgFeature.bits.LinkSpeedPowerMode;
+        DEVICE.CpmuControl = cpmu_control;
+        // Release grant.
+        Lock_release(LOCK_GRC_MUTEX);
     }
 
-    // Set REG_LINK_AWARE_POWER_MODE_CLOCK_POLICY to MAC_CLOCK_SWITCH__6_25MHZ.
-    RegDEVICELinkAwarePowerModeClockPolicy_t lapmcp;
-    lapmcp.r32 = 0;
-    lapmcp.bits.MACClockSwitch = DEVICE_LINK_AWARE_POWER_MODE_CLOCK_POLICY_MAC_CLOCK_SWITCH_6_25MHZ;
-    DEVICE.LinkAwarePowerModeClockPolicy = lapmcp;
-    // Set REG_CPMU_CONTROL to zero or more of LINK_AWARE_POWER_MODE_ENABLE, LINK_IDLE_POWER_MODE_ENABLE, LINK_SPEED_POWER_MODE_ENABLE as desired (see NVM CfgFeature).
-    RegDEVICECpmuControl_t cpmu_control;
-    cpmu_control.r32 = 0;
-    cpmu_control.bits.LinkIdlePowerModeEnable  = GEN.GenCfgFeature.bits.LinkIdle;
-    cpmu_control.bits.LinkAwarePowerModeEnable = GEN.GenCfgFeature.bits.LinkAwarePowerMode;
-    cpmu_control.bits.LinkSpeedPowerModeEnable = GEN.GenCfgFeature.bits.LinkSpeedPowerMode;
-    DEVICE.CpmuControl = cpmu_control;
-    // Release grant.
-    DEVICE.MutexGrant.r32 = (1 << 4);
-
-
     // Mask REG_CLOCK_SPEED_OVERRIDE_POLICY__MAC_CLOCK_SPEED_OVERRIDE_ENABLE.
     DEVICE.ClockSpeedOverridePolicy.bits.MACClockSpeedOverrideEnabled = 0;
 
@@ -63,16 +63,92 @@
 #include <bcm5719_SHM.h>
 #include <APE.h>
 
+#include <stdbool.h>
 #include <string.h>
 
 NVRAMContents_t gNVMContents;
 
+bool gBootTimelineReady __attribute__((section(".data")));
+
+/** @brief Size of the blocks of gNVMContents tracked by the NVRAM cache. */
+#define NVM_CACHE_BLOCK_SIZE    (32u)
+
+/** @brief Mask of the cache blocks covering the given bytes of gNVMContents. */
+#define NVM_CACHE_BLOCKS(__offset__, __length__)                                       \
+    (((1u << (((__offset__) + (__length__) + NVM_CACHE_BLOCK_SIZE - 1) / NVM_CACHE_BLOCK_SIZE)) - 1u) & \
+     ~((1u << ((__offset__) / NVM_CACHE_BLOCK_SIZE)) - 1u))
+
+#define NVM_CACHE_ELEMENT(__element__) \
+    NVM_CACHE_BLOCKS(ELEMENT_OFFSET(NVRAMContents_t, __element__), sizeof(gNVMContents.__element__))
+
+_Static_assert(sizeof(NVRAMContents_t) <= NVM_CACHE_BLOCK_SIZE * 31, "NVM cache bitmap is too small.");
+
+/** @brief Blocks of gNVMContents that have been read from NVRAM. */
+static uint32_t gNVMCacheValid;
+
+/**
+ * @fn bool nvm_cache_load(uint32_t blocks)
+ *
+ * @brief Reads any of the given blocks that are not yet cached, using one
+ *        burst per run of missing blocks.
+ *
+ * @returns false if the NVM lock timed out, the blocks are left invalid.
+ */
+static bool nvm_cache_load(uint32_t blocks)
+{
+    uint32_t missing = blocks & ~gNVMCacheValid;
+    uint32_t *words = (uint32_t *)&gNVMContents;
+    uint32_t block = 0;
+
+    if(!missing)
+    {
+        return true;
+    }
+
+    if(!NVRam_acquireLock())
+    {
+        return false;
+    }
+    NVRam_enable();
+
+    while(missing)
+    {
+        if(!(missing & 1))
+        {
+            missing >>= 1;
+            block++;
+            continue;
+        }
+
+        uint32_t start = block * NVM_CACHE_BLOCK_SIZE;
+        while(missing & 1)
+        {
+            missing >>= 1;
+            block++;
+        }
+
+        uint32_t end = block * NVM_CACHE_BLOCK_SIZE;
+        if(end > sizeof(NVRAMContents_t))
+        {
+            end = sizeof(NVRAMContents_t);
+        }
+
+        NVRam_read(start, &words[start / 4], (end - start) / 4);
+    }
+
+    NVRam_releaseLock();
+
+    gNVMCacheValid |= blocks;
+    return true;
+}
+
 int main()
 {
     reportStatus(STATUS_MAIN, 0);
     uint32_t* bootcode_dest;
 #if CXX_SIMULATOR
     initHAL(NULL);
+    initBootTimeline();
     bootcode_dest = (uint32_t*)malloc(REG_BOOTCODE_SIZE);
 #else
     bootcode_dest = (uint32_t*)&BOOTCODE;
@@ -84,15 +160,18 @@ int main()
 #endif
 
     reportStatus(STATUS_MAIN, 1);
-    // Read in the NVM header.
-    NVRam_acquireLock();
+    // Read in the NVM header and the configuration used by init_hw. The VPD
+    // and directory are loaded on first use. Nothing below is usable without
+    // them, so keep retrying while the NVM lock is held elsewhere.
+    while(!nvm_cache_load(NVM_CACHE_ELEMENT(header) |
+                          NVM_CACHE_ELEMENT(info) |
+                          NVM_CACHE_ELEMENT(info2)))
+    {
+        reportStatus(STATUS_MAIN, 0xe1);
+    }
 
     reportStatus(STATUS_MAIN, 2);
 
-    NVRam_enable();
-    NVRam_read(0, (uint32_t *)&gNVMContents, sizeof(NVRAMContents_t) / 4);
-    NVRam_releaseLock();
-
 #if !CXX_SIMULATOR
     load_nvm_config(&gNVMContents);
 
@@ -150,6 +229,14 @@ int main()
         {
             uint32_t vpd_offset = DEVICE.PciVpdRequest.bits.RequestedVPDOffset;
 
+            if(vpd_offset + 4 <= sizeof(gNVMContents.vpd) &&
+               !nvm_cache_load(NVM_CACHE_BLOCKS(ELEMENT_OFFSET(NVRAMContents_t, vpd) + vpd_offset, 4)))
+            {
+                // Leave the request pending and retry rather than answer
+                // with data that was never read.
+                continue;
+            }
+
             union
             {
                 uint8_t r8[4];
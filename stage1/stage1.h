@@ -47,6 +47,9 @@
 
 #include <bcm5719_eeprom.h>
 #include <bcm5719_GEN.h>
+#include <bcm5719_DEVICE.h>
+#include <bcm5719_SHM.h>
+#include <stdbool.h>
 
 void early_init_hw(void);
 void load_nvm_config(NVRAMContents_t *nvram);
@@ -57,9 +60,39 @@ void init_hw(NVRAMContents_t *nvram);
 #define STATUS_NVM_CONFIG   (0x8234900u)
 #define STATUS_INIT_HW      (0x8234A00u)
 
+/** @brief Number of (status, DEVICE.Timer) pairs in SHM.RcpuBootTimeline. */
+#define BOOT_TIMELINE_ENTRIES \
+    (sizeof(SHM.RcpuBootTimeline) / sizeof(SHM.RcpuBootTimeline[0]) / 2)
+
+/**
+ * @brief Set by initBootTimeline once SHM is writable. Lives in .data, since
+ *        .bss is only cleared part way through early_init_hw.
+ */
+extern bool gBootTimelineReady;
+
+/** @brief Clears the boot timeline, SHM must be writable. */
+static inline void initBootTimeline(void)
+{
+    SHM.RcpuBootTimelineCount.r32 = 0;
+    gBootTimelineReady = true;
+}
+
 static inline void reportStatus(uint32_t code, uint8_t step)
 {
     GEN.GenDataSig.r32 = (code | step);
+
+    if (!gBootTimelineReady)
+    {
+        // SHM is not writable yet and the ring has not been cleared.
+        return;
+    }
+
+    // Log the step with a timestamp, overwriting the oldest entry when full.
+    uint32_t count = SHM.RcpuBootTimelineCount.r32;
+    uint32_t index = (count % BOOT_TIMELINE_ENTRIES) * 2;
+    SHM.RcpuBootTimeline[index].r32 = (code | step);
+    SHM.RcpuBootTimeline[index + 1].r32 = DEVICE.Timer.r32;
+    SHM.RcpuBootTimelineCount.r32 = count + 1;
 }
 
 
@@ -204,7 +204,7 @@ int main(int argc, char const *argv[])
         inBufferSize = section->compressedSize;
         outBufferPtr = (uint8_t *)malloc(section->decompressedSize);
         outBufferSize = section->decompressedSize;
-        out_length = decompress(outBufferPtr, outBufferSize, inBufferPtr, inBufferSize);
+        out_length = decompress_fast(outBufferPtr, outBufferSize, inBufferPtr, inBufferSize);
         calculated_crc = NVRam_crc(outBufferPtr, outBufferSize, 0);
         printf("out_length:                0x%08zX\n", out_length);
         printf("out CRC:                 0x%08X\n", calculated_crc);
@@ -44,6 +44,7 @@
 
 #include "HAL.hpp"
 
+#include <Lock.h>
 #include <NVRam.h>
 #include <bcm5719_eeprom.h>
 #include <dirent.h>
@@ -63,6 +64,10 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <map>
+#include <signal.h>
+#include <poll.h>
+#include <sys/wait.h>
 
 #include "../NVRam/bcm5719_NVM.h"
 
@@ -87,7 +92,646 @@ bool save_to_file(const char* filename, void* buffer, size_t size)
     }
 }
 
-#define NVRAM_SIZE      (1024u * 256u) /* 256KB */
+
+#define NVRAM_STREAM_CHUNK_WORDS    (256u)
+
+typedef struct {
+    uint32_t    start;      /*< NVRAM offset of the first byte covered. */
+    uint32_t    length;     /*< Bytes covered, 0 until the header is read. */
+    uint32_t    done;       /*< Bytes added to the CRC so far. */
+    uint32_t    crc;
+} stream_crc_t;
+
+typedef struct {
+    const uint8_t*  image;
+    stream_crc_t    stage1;
+    stream_crc_t    stage2;
+} stream_state_t;
+
+static void stream_crc_update(stream_crc_t* range, const uint8_t* image, uint32_t available)
+{
+    uint32_t end = range->start + range->length;
+    uint32_t from = range->start + range->done;
+
+    if(available > end)
+    {
+        available = end;
+    }
+
+    if(range->length && available > from)
+    {
+        range->crc = NVRam_crc(&image[from], available - from, range->crc);
+        range->done += available - from;
+    }
+}
+
+static bool stream_range_init(stream_crc_t* range, uint32_t start, uint32_t length)
+{
+    if(start >= NVRAM_SIZE || length > NVRAM_SIZE - start)
+    {
+        // Invalid header, leave the CRC to be computed after the read.
+        return false;
+    }
+
+    range->start = start;
+    range->length = length;
+    range->done = 0;
+    range->crc = 0xffffffff;
+    return true;
+}
+
+/**
+ * @brief Locates the stage images as soon as their headers arrive and adds
+ *        each chunk to their CRCs while it is still in the cache.
+ */
+static bool stream_chunk(uint32_t address, uint32_t* words, size_t count, void* context)
+{
+    stream_state_t* state = (stream_state_t*)context;
+    const NVRAMContents_t* contents = (const NVRAMContents_t*)state->image;
+    uint32_t available = address + count * 4;
+
+    if(!state->stage1.length && available >= sizeof(NVRAMHeader_t))
+    {
+        stream_range_init(&state->stage1,
+                          be32toh(contents->header.bootstrapOffset),
+                          (be32toh(contents->header.bootstrapWords) * 4) - 4);
+    }
+
+    // The stage2 header immediately follows the stage1 CRC word.
+    uint32_t stage2 = state->stage1.start + state->stage1.length + 4;
+    if(state->stage1.length && !state->stage2.length &&
+       available >= stage2 + sizeof(NVRAMStage2Header_t))
+    {
+        const NVRAMStage2Header_t* header = (const NVRAMStage2Header_t*)&state->image[stage2];
+        stream_range_init(&state->stage2, stage2 + sizeof(NVRAMStage2Header_t),
+                          be32toh(header->length) - 4);
+    }
+
+    stream_crc_update(&state->stage1, state->image, available);
+    stream_crc_update(&state->stage2, state->image, available);
+
+    return true;
+}
+
+/**
+ * @brief Returns the CRC of the given range, using the value computed while
+ *        streaming if it covers the same bytes.
+ */
+static uint32_t stream_crc(const stream_crc_t& range, const uint8_t* image, uint32_t start, uint32_t length)
+{
+    if(range.length && range.start == start && range.length == length && range.done == length)
+    {
+        return range.crc;
+    }
+
+    return NVRam_crc(&image[start], length, 0xffffffff);
+}
+
+/** @brief Reads the given bytes of NVRAM into image, clamped to the device size. */
+static void read_region(uint32_t* image, uint32_t offset, uint32_t length)
+{
+    if(offset >= NVRAM_SIZE)
+    {
+        return;
+    }
+
+    if(length > NVRAM_SIZE - offset)
+    {
+        length = NVRAM_SIZE - offset;
+    }
+
+    uint32_t first = offset / 4;
+    uint32_t last = (offset + length + 3) / 4;
+    NVRam_read(first * 4, &image[first], last - first);
+}
+
+/**
+ * @brief Reads only what the report uses: the header, directory, info and VPD
+ *        blocks, then the stage1 and stage2 images located through them.
+ *
+ * The page cache serves the pages these regions share, so each page is read
+ * from the flash once.
+ */
+static void read_for_inspection(uint32_t* image)
+{
+    const NVRAMContents_t* contents = (const NVRAMContents_t*)image;
+
+    NVRam_enableCache(true);
+
+    read_region(image, 0, sizeof(NVRAMContents_t));
+
+    uint32_t stage1 = be32toh(contents->header.bootstrapOffset);
+    uint32_t stage1_bytes = be32toh(contents->header.bootstrapWords) * 4;
+    read_region(image, stage1, stage1_bytes);
+
+    // The stage2 header immediately follows the stage1 CRC word.
+    uint32_t stage2 = stage1 + stage1_bytes;
+    read_region(image, stage2, sizeof(NVRAMStage2Header_t));
+    if(stage2 + sizeof(NVRAMStage2Header_t) <= NVRAM_SIZE)
+    {
+        const NVRAMStage2Header_t* header = (const NVRAMStage2Header_t*)((const uint8_t*)image + stage2);
+        read_region(image, stage2, sizeof(NVRAMStage2Header_t) + be32toh(header->length));
+    }
+
+    const NVRamCacheStats_t* cache = NVRam_getCacheStats();
+    printf("NVM cache: %u hits, %u misses, %u pages read.\n",
+           cache->hits, cache->misses, cache->pagesRead);
+
+    NVRam_enableCache(false);
+}
+
+static volatile sig_atomic_t gInterrupted;
+
+/**
+ * @brief Result of one write_to_hardware call, sent from a fleet worker to
+ *        the parent so the report does not depend on the printed messages.
+ */
+typedef struct {
+    uint32_t    written;        /*< Pages programmed. */
+    uint32_t    pages;          /*< Pages in the image. */
+    uint32_t    failed;         /*< Pages that failed verification. */
+    uint32_t    interrupted;    /*< Non-zero if stopped by SIGINT. */
+} fleet_result_t;
+
+/** @brief Write end of the result pipe in a fleet worker, -1 otherwise. */
+static int gResultFd = -1;
+
+static void send_result(const fleet_result_t& result)
+{
+    // Records are smaller than PIPE_BUF, so each write is atomic.
+    if(gResultFd >= 0 && write(gResultFd, &result, sizeof(result)) != sizeof(result))
+    {
+        cerr << "Unable to send the result: " << strerror(errno) << endl;
+    }
+}
+
+static void interrupt_handler(int signal)
+{
+    // Stop after the current page so the NVM lock is released cleanly.
+    gInterrupted = 1;
+}
+
+#define JOURNAL_MAGIC           "bcmflash-journal"
+#define JOURNAL_SPOT_CHECKS     (4u)
+
+/**
+ * @brief Pages of a --restore image that an earlier run already programmed
+ *        and verified, so a rerun neither reads nor verifies them again.
+ */
+typedef struct {
+    string                  path;
+    uint32_t                imageCrc;   /*< NVRam_crc of the whole target image. */
+    map<size_t, uint32_t>   pages;      /*< Completed pages and the CRC of their contents. */
+    FILE*                   file;
+} journal_t;
+
+static uint32_t page_crc(const uint32_t* words, size_t page)
+{
+    const size_t page_words = NVRAM_PAGE_SIZE / 4;
+    size_t first = page * page_words;
+    size_t count = min(page_words, NVRAM_SIZE / 4 - first);
+
+    return NVRam_crc((const uint8_t*)&words[first], count * 4, 0xffffffff);
+}
+
+/**
+ * @brief Loads the pages recorded for image. Records written for a different
+ *        image, or that don't match it, are ignored.
+ */
+static void load_journal(journal_t& journal, const uint32_t* image)
+{
+    size_t pages = NVRAM_PAGE_COUNT(0, NVRAM_SIZE / 4);
+    char magic[32];
+    uint32_t crc;
+    size_t count;
+    size_t page;
+
+    journal.imageCrc = NVRam_crc((const uint8_t*)image, NVRAM_SIZE, 0xffffffff);
+    journal.pages.clear();
+    journal.file = NULL;
+
+    FILE* in = fopen(journal.path.c_str(), "r");
+    if(!in)
+    {
+        return;
+    }
+
+    if(3 == fscanf(in, "%31s %x %zu", magic, &crc, &count) &&
+       0 == strcmp(magic, JOURNAL_MAGIC) && crc == journal.imageCrc && count == pages)
+    {
+        while(2 == fscanf(in, "%zu %x", &page, &crc))
+        {
+            if(page < pages && crc == page_crc(image, page))
+            {
+                journal.pages[page] = crc;
+            }
+        }
+    }
+
+    fclose(in);
+}
+
+/**
+ * @brief Reads back a few of the journaled pages and drops the journal if
+ *        any no longer match, e.g. when another agent changed the flash.
+ *
+ * Must be called with the NVM lock held.
+ */
+static void check_journal(journal_t& journal)
+{
+    const size_t page_words = NVRAM_PAGE_SIZE / 4;
+    size_t step = max<size_t>(1, journal.pages.size() / JOURNAL_SPOT_CHECKS);
+    vector<uint32_t> flash(NVRAM_SIZE / 4);
+    size_t index = 0;
+
+    for(map<size_t, uint32_t>::iterator entry = journal.pages.begin();
+        entry != journal.pages.end(); ++entry, ++index)
+    {
+        // Spread the checks over the journal, always including the last page.
+        if(index % step && next(entry) != journal.pages.end())
+        {
+            continue;
+        }
+
+        size_t first = entry->first * page_words;
+        NVRam_read(first * 4, &flash[first], min(page_words, NVRAM_SIZE / 4 - first));
+        if(page_crc(flash.data(), entry->first) != entry->second)
+        {
+            printf("Journal %s does not match the flash, reading all pages.\n", journal.path.c_str());
+            journal.pages.clear();
+            return;
+        }
+    }
+
+    if(!journal.pages.empty())
+    {
+        printf("Resuming from %s, %zu pages already programmed.\n",
+               journal.path.c_str(), journal.pages.size());
+    }
+}
+
+/**
+ * @brief Fills words with the current flash contents. Journaled pages are
+ *        taken from image instead of being read.
+ *
+ * Must be called with the NVM lock held.
+ */
+static void read_unjournaled(uint32_t* words, const uint32_t* image, const journal_t& journal)
+{
+    const size_t page_words = NVRAM_PAGE_SIZE / 4;
+    size_t pages = NVRAM_PAGE_COUNT(0, NVRAM_SIZE / 4);
+
+    memcpy(words, image, NVRAM_SIZE);
+
+    for(size_t page = 0; page < pages;)
+    {
+        if(journal.pages.count(page))
+        {
+            page++;
+            continue;
+        }
+
+        // Read each run of pages not in the journal with a single burst.
+        size_t end = page + 1;
+        while(end < pages && !journal.pages.count(end))
+        {
+            end++;
+        }
+
+        size_t first = page * page_words;
+        size_t last = min(end * page_words, (size_t)NVRAM_SIZE / 4);
+        NVRam_read(first * 4, &words[first], last - first);
+        page = end;
+    }
+}
+
+static bool open_journal(journal_t& journal, size_t pages)
+{
+    journal.file = fopen(journal.path.c_str(), journal.pages.empty() ? "w" : "a");
+    if(!journal.file)
+    {
+        cerr << "Unable to open journal " << journal.path << "." << endl;
+        return false;
+    }
+
+    if(journal.pages.empty())
+    {
+        fprintf(journal.file, "%s %08x %zu\n", JOURNAL_MAGIC, journal.imageCrc, pages);
+    }
+
+    return true;
+}
+
+static void sync_journal(journal_t& journal)
+{
+    fflush(journal.file);
+    fsync(fileno(journal.file));
+}
+
+/**
+ * @brief Programs the pages of words that differ from before, the flash
+ *        contents read at startup.
+ *
+ * With a journal, every page found complete is recorded, so that an
+ * interrupted update can resume without reading those pages again. The
+ * journal is removed once the whole image has been programmed.
+ */
+bool write_to_hardware(const uint32_t* before, const uint32_t* words, size_t numWords, journal_t* journal)
+{
+    const size_t page_words = NVRAM_PAGE_SIZE / 4;
+    size_t pages = NVRAM_PAGE_COUNT(0, numWords);
+    vector<NVRamPageStatus_t> status(pages, NVRAM_PAGE_UNCHANGED);
+    size_t written = 0;
+    size_t failed = 0;
+
+    if(journal && !open_journal(*journal, pages))
+    {
+        return false;
+    }
+
+    if(!NVRam_acquireLock())
+    {
+        cerr << "Timed out waiting for the NVM lock." << endl;
+        if(journal)
+        {
+            fclose(journal->file);
+            journal->file = NULL;
+        }
+        return false;
+    }
+
+    gInterrupted = 0;
+    sighandler_t old_handler = signal(SIGINT, interrupt_handler);
+
+    NVRam_enable();
+    NVRam_enableWrites();
+
+    for(size_t i = 0; i < pages && !gInterrupted; i++)
+    {
+        size_t first = i * page_words;
+        size_t count = min(page_words, numWords - first);
+
+        // Only pages that differ from the image read at startup are programmed.
+        written += NVRam_writeChanged(first * 4, &before[first], &words[first], count, &status[i]);
+
+        if(journal && NVRAM_PAGE_VERIFY_FAILED != status[i] && !journal->pages.count(i))
+        {
+            fprintf(journal->file, "%zu %08x\n", i, page_crc(words, i));
+            if(NVRAM_PAGE_WRITTEN == status[i])
+            {
+                sync_journal(*journal);
+            }
+        }
+    }
+
+    NVRam_disableWrites();
+
+    NVRam_releaseLock();
+
+    signal(SIGINT, old_handler);
+
+    for(size_t i = 0; i < status.size(); i++)
+    {
+        if(NVRAM_PAGE_WRITTEN == status[i])
+        {
+            printf("Wrote page %zu (0x%05zx).\n", i, i * NVRAM_PAGE_SIZE);
+        }
+        else if(NVRAM_PAGE_VERIFY_FAILED == status[i])
+        {
+            cerr << "Verification failed for page " << i << "." << endl;
+            failed++;
+        }
+    }
+    printf("Wrote %zu of %zu pages, %zu failed verification.\n", written, pages, failed);
+
+    fleet_result_t result = { (uint32_t)written, (uint32_t)pages, (uint32_t)failed, (uint32_t)gInterrupted };
+    send_result(result);
+
+    const LockStats_t* lock = Lock_getStats(LOCK_NVM);
+    printf("NVM lock: %u acquisitions, %u contended, %u timeouts, max wait %u us.\n",
+           lock->acquisitions, lock->contended, lock->timeouts, lock->maxWait);
+
+    if(journal)
+    {
+        sync_journal(*journal);
+        fclose(journal->file);
+        journal->file = NULL;
+
+        if(!failed && !gInterrupted)
+        {
+            // The update is complete, nothing left to resume.
+            remove(journal->path.c_str());
+        }
+    }
+
+    if(gInterrupted)
+    {
+        cerr << "Interrupted, rerun the same command to program the remaining pages." << endl;
+        return false;
+    }
+
+    return !failed;
+}
+
+typedef struct {
+    string  device;
+    pid_t   pid;
+    int     fd;
+    string  output;
+    int     status;
+    int     resultFd;   /*< Read end of the worker's fleet_result_t pipe. */
+    size_t  results;    /*< Number of results received. */
+    fleet_result_t result;  /*< Sum of the results received. */
+} fleet_worker_t;
+
+static string device_name(const string& device)
+{
+    // sysfs paths end in '/', model:// and replay:// devices name a file.
+    string name = device;
+    while(!name.empty() && '/' == name[name.size() - 1])
+    {
+        name.erase(name.size() - 1);
+    }
+
+    size_t slash = name.rfind('/');
+    return (string::npos == slash) ? name : name.substr(slash + 1);
+}
+
+/**
+ * @brief Start one worker process per device.
+ *
+ * Every worker maps its own device and takes its own NVM lock, the register
+ * blocks are process globals so workers are processes rather than threads.
+ *
+ * @returns true in a worker, with device set to the device it should use.
+ *          false in the parent once all workers have been started.
+ */
+static bool fork_workers(const vector<string>& devices, vector<fleet_worker_t>& workers, string& device)
+{
+    fflush(NULL);
+
+    for(size_t i = 0; i < devices.size(); i++)
+    {
+        int fds[2];
+        int results[2];
+        if(pipe(fds) || pipe(results))
+        {
+            cerr << "Unable to create pipe: " << strerror(errno) << endl;
+            exit(-1);
+        }
+
+        pid_t pid = fork();
+        if(pid < 0)
+        {
+            cerr << "Unable to start worker: " << strerror(errno) << endl;
+            exit(-1);
+        }
+        else if(0 == pid)
+        {
+            for(size_t j = 0; j < workers.size(); j++)
+            {
+                close(workers[j].fd);
+                close(workers[j].resultFd);
+            }
+
+            close(fds[0]);
+            close(results[0]);
+            gResultFd = results[1];
+            dup2(fds[1], STDOUT_FILENO);
+            dup2(fds[1], STDERR_FILENO);
+            close(fds[1]);
+            setvbuf(stdout, NULL, _IOLBF, 0);
+
+            device = devices[i];
+            return true;
+        }
+
+        close(fds[1]);
+        close(results[1]);
+
+        fleet_worker_t worker = { devices[i], pid, fds[0], "", 0, results[0], 0, { 0, 0, 0, 0 } };
+        workers.push_back(worker);
+    }
+
+    return false;
+}
+
+static void collect_workers(vector<fleet_worker_t>& workers)
+{
+    // Workers finish the page in progress on ^C, wait for them to do so.
+    signal(SIGINT, SIG_IGN);
+
+    size_t open = workers.size();
+    while(open)
+    {
+        vector<pollfd> fds;
+        for(size_t i = 0; i < workers.size(); i++)
+        {
+            pollfd fd = { workers[i].fd, POLLIN, 0 };
+            fds.push_back(fd);
+        }
+
+        if(poll(fds.data(), fds.size(), -1) < 0)
+        {
+            if(EINTR == errno)
+            {
+                continue;
+            }
+            break;
+        }
+
+        for(size_t i = 0; i < workers.size(); i++)
+        {
+            if(fds[i].revents)
+            {
+                char buffer[4096];
+                ssize_t count = read(workers[i].fd, buffer, sizeof(buffer));
+                if(count > 0)
+                {
+                    workers[i].output.append(buffer, count);
+                }
+                else if(count == 0 || EINTR != errno)
+                {
+                    close(workers[i].fd);
+                    workers[i].fd = -1;
+                    open--;
+                }
+            }
+        }
+    }
+
+    for(size_t i = 0; i < workers.size(); i++)
+    {
+        if(workers[i].fd >= 0)
+        {
+            close(workers[i].fd);
+        }
+
+        while(waitpid(workers[i].pid, &workers[i].status, 0) < 0 && EINTR == errno);
+
+        // The worker has exited, so every record it sent is in the pipe.
+        fleet_result_t result;
+        while(read(workers[i].resultFd, &result, sizeof(result)) == sizeof(result))
+        {
+            workers[i].results++;
+            workers[i].result.written += result.written;
+            workers[i].result.pages = result.pages;
+            workers[i].result.failed += result.failed;
+            workers[i].result.interrupted |= result.interrupted;
+        }
+        close(workers[i].resultFd);
+    }
+}
+
+static string worker_summary(const fleet_worker_t& worker)
+{
+    if(!worker.results)
+    {
+        return "no pages programmed";
+    }
+
+    char summary[96];
+    snprintf(summary, sizeof(summary), "wrote %u of %u pages, %u failed verification%s",
+             worker.result.written, worker.result.pages, worker.result.failed,
+             worker.result.interrupted ? ", interrupted" : "");
+    return summary;
+}
+
+static bool print_fleet_report(const vector<fleet_worker_t>& workers)
+{
+    size_t succeeded = 0;
+
+    for(size_t i = 0; i < workers.size(); i++)
+    {
+        printf("=== %s ===\n%s\n", workers[i].device.c_str(), workers[i].output.c_str());
+    }
+
+    printf("=== Fleet Report ===\n");
+    for(size_t i = 0; i < workers.size(); i++)
+    {
+        const fleet_worker_t& worker = workers[i];
+        char result[32];
+        if(WIFEXITED(worker.status) && 0 == WEXITSTATUS(worker.status))
+        {
+            snprintf(result, sizeof(result), "ok");
+            succeeded++;
+        }
+        else if(WIFEXITED(worker.status))
+        {
+            snprintf(result, sizeof(result), "exit %d", WEXITSTATUS(worker.status));
+        }
+        else
+        {
+            snprintf(result, sizeof(result), "signal %d", WTERMSIG(worker.status));
+        }
+
+        printf("%-24s %-10s %s\n", device_name(worker.device).c_str(), result, worker_summary(worker).c_str());
+    }
+    printf("%zu of %zu devices succeeded.\n", succeeded, workers.size());
+
+    return succeeded == workers.size();
+}
+
 int main(int argc, char const *argv[])
 {
     bool extract = false;
@@ -96,6 +740,8 @@ int main(int argc, char const *argv[])
         uint32_t        words[NVRAM_SIZE/4];
         NVRAMContents_t contents;
     } nvram;
+    vector<uint32_t> original;
+    stream_state_t stream = { nvram.bytes };
 
     OptionParser parser = OptionParser().description("BCM Flash Utility");
 
@@ -134,6 +780,12 @@ int main(int argc, char const *argv[])
             .help("Update the target with the specified stage2 image, if possible.")
             .metavar("STAGE2");
 
+    parser.add_option("-j", "--journal")
+            .dest("journal")
+            .help("Record the pages completed by --restore, so an interrupted "
+                  "update resumes without reading them again.")
+            .metavar("JOURNAL");
+
     parser.add_option("-u", "--unlock")
             .dest("unlock")
             .action("store_true")
@@ -141,6 +793,34 @@ int main(int argc, char const *argv[])
             .help("Clear all NVM locks.")
             .metavar("STAGE1");
 
+    parser.add_option("-d", "--device")
+            .dest("device")
+            .action("append")
+            .help("Use the specified device instead of the first one found. "
+                  "May be repeated with --fleet.")
+            .metavar("PCI_PATH");
+
+    parser.add_option("--fleet")
+            .dest("fleet")
+            .action("store_true")
+            .set_default("0")
+            .help("Run on every supported NIC in parallel and print a combined report.");
+
+    parser.add_option("--trace")
+            .dest("trace")
+            .help("Record all register accesses to the specified file.")
+            .metavar("TRACE_FILE");
+
+    parser.add_option("--replay")
+            .dest("replay")
+            .help("Use a trace recorded with --trace instead of the attached device.")
+            .metavar("TRACE_FILE");
+
+    parser.add_option("--model")
+            .dest("model")
+            .help("Use a software model of the device with the specified NVRAM contents.")
+            .metavar("NVRAM_FILE");
+
     parser.add_option("-q", "--quiet")
             .action("store_false")
             .dest("verbose")
@@ -149,6 +829,70 @@ int main(int argc, char const *argv[])
 
     optparse::Values options = parser.parse_args(argc, argv);
     vector<string> args = parser.args();
+    string device = options.is_set("device") ? options["device"] : "";
+    bool inspect_only = !options.is_set("restore") && !options.is_set("backup") &&
+                        !options.is_set("stage1") && !options.is_set("stage2");
+    journal_t journal;
+    vector<uint32_t> target;
+
+    if(options.is_set("journal"))
+    {
+        if("hardware" != options["target"] || !options.is_set("restore") || options.get("fleet"))
+        {
+            cerr << "--journal requires -t hardware and --restore, and cannot be "
+                    "combined with --fleet." << endl;
+            exit(-1);
+        }
+
+        // The journal is keyed on the target image, so load it before the flash.
+        target.resize(NVRAM_SIZE / 4);
+        ifstream restoreFile(options["restore"], ifstream::binary);
+        if(!restoreFile.read((char*)target.data(), NVRAM_SIZE))
+        {
+            cerr << "--journal requires a complete " << NVRAM_SIZE << " byte image in '"
+                 << options["restore"] << "'" << endl;
+            exit(-1);
+        }
+
+        journal.path = options["journal"];
+        load_journal(journal, target.data());
+    }
+
+    if(options.get("fleet"))
+    {
+        if("hardware" != options["target"] || options.is_set("backup") ||
+           options.is_set("trace") || options.is_set("replay") || options.is_set("model"))
+        {
+            cerr << "--fleet requires -t hardware and cannot be combined with "
+                    "--backup, --trace, --replay or --model." << endl;
+            exit(-1);
+        }
+
+        vector<string> devices;
+        if(options.is_set("device"))
+        {
+            const list<string>& all = options.all("device");
+            devices.assign(all.begin(), all.end());
+        }
+        else
+        {
+            // One worker per physical NIC, all functions share the NVRAM.
+            devices = locateDevices(0);
+        }
+
+        if(devices.empty())
+        {
+            cerr << "No supported devices found." << endl;
+            exit(-1);
+        }
+
+        vector<fleet_worker_t> workers;
+        if(!fork_workers(devices, workers, device))
+        {
+            collect_workers(workers);
+            exit(print_fleet_report(workers) ? 0 : -1);
+        }
+    }
 
     if("file" == options["target"])
     {
@@ -176,7 +920,21 @@ int main(int argc, char const *argv[])
     }
     else if("hardware" == options["target"])
     {
-        if(!initHAL(NULL))
+        if(options.is_set("trace") && !MMIOTrace_start(options["trace"].c_str()))
+        {
+            exit(-1);
+        }
+
+        if(options.is_set("replay"))
+        {
+            device = "replay://" + options["replay"];
+        }
+        else if(options.is_set("model"))
+        {
+            device = "model://" + options["model"];
+        }
+
+        if(!initHAL(device.empty() ? NULL : device.c_str()))
         {
             exit(-1);
         }
@@ -185,6 +943,8 @@ int main(int argc, char const *argv[])
 
         if(options.get("unlock"))
         {
+            // Combine all lock clears into a single register write.
+            RegisterTransaction unlock(NVM.SoftwareArbitration.r32);
             NVM.SoftwareArbitration.bits.ReqClr0 = 1;
             NVM.SoftwareArbitration.bits.ReqClr1 = 1;
             NVM.SoftwareArbitration.bits.ReqClr2 = 1;
@@ -192,13 +952,35 @@ int main(int argc, char const *argv[])
         }
 
 
-        NVRam_acquireLock();
+        if(!NVRam_acquireLock())
+        {
+            cerr << "Timed out waiting for the NVM lock, try --unlock." << endl;
+            exit(-1);
+        }
 
         NVRam_enable();
 
-        NVRam_read(0, nvram.words, NVRAM_SIZE / 4);
+        if(!target.empty())
+        {
+            check_journal(journal);
+            read_unjournaled(nvram.words, target.data(), journal);
+        }
+        else if(inspect_only)
+        {
+            // Nothing is written, skip the unused parts of the flash.
+            memset(nvram.bytes, 0xFF, sizeof(nvram.bytes));
+            read_for_inspection(nvram.words);
+        }
+        else
+        {
+            NVRam_readStream(0, NVRAM_SIZE / 4, nvram.words, NVRAM_SIZE / 4,
+                             NVRAM_STREAM_CHUNK_WORDS, stream_chunk, &stream);
+        }
 
         NVRam_releaseLock();
+
+        // Keep the current contents to find the pages that need programming.
+        original.assign(nvram.words, nvram.words + NVRAM_SIZE / 4);
     }
     else
     {
@@ -215,6 +997,10 @@ int main(int argc, char const *argv[])
         {
             restoreFile.read((char*)nvram.bytes, NVRAM_SIZE);
 
+            // The CRCs computed while streaming no longer match the contents.
+            stream.stage1.length = 0;
+            stream.stage2.length = 0;
+
             restoreFile.close();
         }
         else
@@ -225,16 +1011,11 @@ int main(int argc, char const *argv[])
 
         if("hardware" == options["target"])
         {
-            NVRam_acquireLock();
-
-            NVRam_enable();
-            NVRam_enableWrites();
-
-            NVRam_write(0, nvram.words, NVRAM_SIZE / 4);
-
-            NVRam_disableWrites();
-
-            NVRam_releaseLock();
+            if(!write_to_hardware(original.data(), nvram.words, NVRAM_SIZE / 4,
+                                  target.empty() ? NULL : &journal))
+            {
+                exit(-1);
+            }
         }
         else
         {
@@ -271,7 +1052,7 @@ int main(int argc, char const *argv[])
 
     uint32_t crc_word = stage1_length / 4;
 
-    uint32_t expected_crc = be32toh(~NVRam_crc(stage1, stage1_length, 0xffffffff));
+    uint32_t expected_crc = be32toh(~stream_crc(stream.stage1, nvram.bytes, stage1 - nvram.bytes, stage1_length));
     printf("=== stage1 ===\n");
     printf("Magic:               0x%08X\n", be32toh(nvram.contents.header.magic));
     printf("Bootstrap Phys Addr: 0x%08X\n",
@@ -354,16 +1135,10 @@ int main(int argc, char const *argv[])
 
             if("hardware" == options["target"])
             {
-                NVRam_acquireLock();
-
-                NVRam_enable();
-                NVRam_enableWrites();
-
-                NVRam_write(0, nvram.words, NVRAM_SIZE / 4);
-
-                NVRam_disableWrites();
-
-                NVRam_releaseLock();
+                if(!write_to_hardware(original.data(), nvram.words, NVRAM_SIZE / 4, NULL))
+                {
+                    exit(-1);
+                }
             }
         }
         else
@@ -386,7 +1161,7 @@ int main(int argc, char const *argv[])
     printf("Magic:               0x%08X\n", be32toh(stage2->header.magic));
     printf("Length (bytes):      0x%08X\n", stage2_length);
     printf("Offset:              0x%08lX\n", ((stage2_wd - nvram.words) * 4));
-    uint32_t stage2_expected_crc = be32toh(~NVRam_crc((uint8_t*)stage2->words, stage2_length, 0xffffffff));
+    uint32_t stage2_expected_crc = be32toh(~stream_crc(stream.stage2, nvram.bytes, (uint8_t*)stage2->words - nvram.bytes, stage2_length));
     printf("Calculated CRC:      0x%08X\n", stage2_expected_crc);
     printf("CRC:                 0x%08X\n", be32toh(stage2->words[stage2_crc_word]));
 
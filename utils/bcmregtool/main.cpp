@@ -77,6 +77,7 @@
 #include <NCSI.h>
 
 #include "../NVRam/bcm5719_NVM.h"
+#include "../../stage1/stage1.h"
 
 using namespace std;
 using namespace ELFIO;
@@ -133,27 +134,38 @@ void boot_ape_loader()
 
     // Wait for ready.
     while(0 == SHM.FwStatus.bits.Ready);
+
+    APELoader_initRing();
 }
 
-uint32_t loader_read_mem(uint32_t addr)
+#define APE_DELTA_BLOCK_WORDS   (256)   /* One loader staging buffer. */
+
+void upload_ape_delta(uint32_t addr, const uint32_t *words, int numWords)
 {
-    SHM.LoaderArg0.r32 = addr;
-    SHM.LoaderCommand.bits.Command = SHM_LOADER_COMMAND_COMMAND_READ_MEM;
+    int blocks = 0;
+    int changed = 0;
+    size_t sent = 0;
 
-    // Wait for command to be handled.
-    while(0 != SHM.LoaderCommand.bits.Command);
+    for(int i = 0; i < numWords; i += APE_DELTA_BLOCK_WORDS)
+    {
+        int blockWords = numWords - i;
+        if(blockWords > APE_DELTA_BLOCK_WORDS)
+        {
+            blockWords = APE_DELTA_BLOCK_WORDS;
+        }
 
-    return (uint32_t)SHM.LoaderArg0.r32;
-}
+        uint32_t blockAddr = addr + i * 4;
+        uint32_t expected = NVRam_crc((const uint8_t*)&words[i], blockWords * 4, 0xffffffff);
 
-void loader_write_mem(uint32_t addr, uint32_t value)
-{
-    SHM.LoaderArg0.r32 = addr;
-    SHM.LoaderArg1.r32 = value;
-    SHM.LoaderCommand.bits.Command = SHM_LOADER_COMMAND_COMMAND_WRITE_MEM;
+        blocks++;
+        if(expected != APELoader_crc(blockAddr, blockWords * 4))
+        {
+            sent += APELoader_writeCompressed(blockAddr, &words[i], blockWords);
+            changed++;
+        }
+    }
 
-    // Wait for command to be handled.
-    while(0 != SHM.LoaderCommand.bits.Command);
+    printf("Uploaded %d of %d blocks using %zu bytes of transfers.\n", changed, blocks, sent);
 }
 
 const string symbol_for_address(uint32_t address, uint32_t &offset)
@@ -322,6 +334,105 @@ void step(void)
     }
 }
 
+const char* boot_phase_name(uint32_t status)
+{
+    uint32_t code = status & ~0xFFu;
+    uint32_t step = status & 0xFFu;
+
+    if(GEN_GEN_DATA_SIG_SIG_DRIVER_READY == status)
+    {
+        return "bootcode_ready";
+    }
+
+    switch(code)
+    {
+        case STATUS_MAIN:
+            return "main";
+        case STATUS_EARLY_INIT:
+            return "early_init_hw";
+        case STATUS_NVM_CONFIG:
+            return "load_nvm_config";
+        case STATUS_INIT_HW:
+            // Steps 0xf0 - 0xf7 cover init_mii_function0.
+            return (step >= 0xf0 && step <= 0xf7) ? "init_mii_function0" : "init_hw";
+        default:
+            return "unknown";
+    }
+}
+
+void print_boot_timeline(void)
+{
+    uint32_t count = SHM.RcpuBootTimelineCount.r32;
+    uint32_t entries = count < BOOT_TIMELINE_ENTRIES ? count : BOOT_TIMELINE_ENTRIES;
+    uint32_t first = count - entries;
+    vector< pair<string, uint32_t> > phases;
+
+    printf("=== Boot Timeline ===\n");
+    printf("Entries: %u (%u shown)\n", count, entries);
+    printf("Status      Timer       Delta       Phase\n");
+
+    for(uint32_t i = 0; i < entries; i++)
+    {
+        uint32_t index = ((first + i) % BOOT_TIMELINE_ENTRIES) * 2;
+        uint32_t status = SHM.RcpuBootTimeline[index].r32;
+        uint32_t timer = SHM.RcpuBootTimeline[index + 1].r32;
+        uint32_t delta = 0;
+
+        // Each step lasts until the next one is reported.
+        if(i + 1 < entries)
+        {
+            uint32_t next = ((first + i + 1) % BOOT_TIMELINE_ENTRIES) * 2;
+            delta = SHM.RcpuBootTimeline[next + 1].r32 - timer;
+        }
+
+        const char* phase = boot_phase_name(status);
+        printf("0x%08X  0x%08X  %-10u  %s\n", status, timer, delta, phase);
+
+        if(phases.empty() || phases.back().first != phase)
+        {
+            phases.push_back(make_pair(string(phase), 0u));
+        }
+        phases.back().second += delta;
+    }
+
+    printf("\nPer-phase durations (timer ticks):\n");
+    for(size_t i = 0; i < phases.size(); i++)
+    {
+        printf("%-20s %u\n", phases[i].first.c_str(), phases[i].second);
+    }
+}
+
+#define FILTERS_ELEMENTS    (32)
+#define FILTERS_RULES       (31)
+
+/* Word offsets into the APE filter block. */
+#define FILTERS_WORD(__reg__)       (((uintptr_t)(__reg__) - (uintptr_t)REG_FILTERS_BASE) / 4)
+#define FILTERS_WORDS               (FILTERS_WORD(REG_FILTERS_RULE_MASK) + FILTERS_RULES)
+
+void print_filters(void)
+{
+    uint32_t words[FILTERS_WORDS];
+
+    // Read the whole table with block commands, not one mailbox command per register.
+    APELoader_readMem((uint32_t)(uintptr_t)REG_FILTERS_BASE, words, FILTERS_WORDS);
+
+    printf("=== APE Filters ===\n");
+    printf("Element  Config      Pattern\n");
+    for(int i = 0; i < FILTERS_ELEMENTS; i++)
+    {
+        printf("%-7d  0x%08X  0x%08X\n", i,
+               words[i], words[FILTERS_WORD(REG_FILTERS_ELEMENT_PATTERN) + i]);
+    }
+
+    printf("\nRule Configuration: 0x%08X\n", words[FILTERS_WORD(REG_FILTERS_RULE_CONFIGURATION)]);
+    printf("Rule     Set         Mask\n");
+    for(int i = 0; i < FILTERS_RULES; i++)
+    {
+        printf("%-7d  0x%08X  0x%08X\n", i,
+               words[FILTERS_WORD(REG_FILTERS_RULE_SET) + i], words[FILTERS_WORD(REG_FILTERS_RULE_MASK) + i]);
+    }
+}
+
 int main(int argc, char const *argv[])
 {
     OptionParser parser = OptionParser().description("BCM Register Utility");
@@ -388,18 +499,60 @@ int main(int argc, char const *argv[])
             .metavar("APE_FILE")
             .help("File to boot on the APE.");
 
+    parser.add_option("--filters")
+            .dest("filters")
+            .set_default("0")
+            .action("store_true")
+            .help("Print the APE management filter table.");
+
+    parser.add_option("--boot-timeline")
+            .dest("boot_timeline")
+            .set_default("0")
+            .action("store_true")
+            .help("Print the stage1 boot timeline with per-phase durations.");
+
     parser.add_option("-m", "--mii")
             .dest("mii")
             .set_default("0")
             .action("store_true")
             .help("Print MII information registers.");
 
+    parser.add_option("--trace")
+            .dest("trace")
+            .metavar("TRACE_FILE")
+            .help("Record all register accesses to the specified file.");
+
+    parser.add_option("--replay")
+            .dest("replay")
+            .metavar("TRACE_FILE")
+            .help("Use a trace recorded with --trace instead of the attached device.");
+
+    parser.add_option("--model")
+            .dest("model")
+            .metavar("NVRAM_FILE")
+            .help("Use a software model of the device with the specified NVRAM contents.");
+
 
     optparse::Values options = parser.parse_args(argc, argv);
     vector<string> args = parser.args();
 
 
-    if(!initHAL(NULL, options.get("function")))
+    if(options.is_set("trace") && !MMIOTrace_start(options["trace"].c_str()))
+    {
+        exit(-1);
+    }
+
+    string device;
+    if(options.is_set("replay"))
+    {
+        device = "replay://" + options["replay"];
+    }
+    else if(options.is_set("model"))
+    {
+        device = "model://" + options["model"];
+    }
+
+    if(!initHAL(device.empty() ? NULL : device.c_str(), options.get("function")))
     {
         cerr << "Unable to locate pci device with function " << (int)options.get("function") << endl;
         exit(-1);
@@ -516,7 +669,6 @@ int main(int argc, char const *argv[])
 
         int fileLength = 0;
         int fileWords = 0;
-        #define NVRAM_SIZE      (1024u * 256u) /* 256KB */
 
         union {
             uint8_t         bytes[NVRAM_SIZE];
@@ -556,12 +708,11 @@ int main(int argc, char const *argv[])
         }
 
 
-        // load file.
-        for(int i = 0; i < fileWords; i++)
-        {
-            uint32_t addr = 0x10D800 + i*4;
-            loader_write_mem(addr, ape.words[i]);
-        }
+        // load file, skipping blocks that are already present.
+        upload_ape_delta(0x10D800, ape.words, fileWords);
+
+        // Nothing may be left in the command ring when the loader is stopped.
+        APELoader_flush();
 
 
         RegAPEMode_t mode;
@@ -583,6 +734,18 @@ int main(int argc, char const *argv[])
         exit(0);
     }
 
+    if(options.get("filters"))
+    {
+        print_filters();
+        exit(0);
+    }
+
+    if(options.get("boot_timeline"))
+    {
+        print_boot_timeline();
+        exit(0);
+    }
+
     if(options.get("ape"))
     {
         APE.Mode.print();
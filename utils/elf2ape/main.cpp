@@ -50,6 +50,9 @@
 
 #include <OptionParser.h>
 #include <elfio/elfio.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace ELFIO;
 
@@ -118,11 +121,57 @@ bool save_to_file(const char* filename, void* buffer, size_t size)
     }
 }
 
+typedef struct {
+    section*        psec;
+    vector<uint8_t> compressed;
+    int32_t         compressedSize;
+    uint32_t        crc;
+} section_job_t;
+
+// Compresses and checksums every section, threads at a time.
+void compress_sections(vector<section_job_t>& jobs, const compress_options_t* compression, unsigned int threads)
+{
+    atomic<size_t> next(0);
+
+    auto worker = [&]()
+    {
+        for(size_t i = next++; i < jobs.size(); i = next++)
+        {
+            section_job_t& job = jobs[i];
+            const char* data = job.psec->get_data();
+            if(!data)
+            {
+                continue;
+            }
+
+            size_t size = job.psec->get_size();
+            job.compressed.resize(size * 2 + 16);
+            job.compressedSize = compress_ex(job.compressed.data(), job.compressed.size(),
+                                             (const uint8_t*)data, size, compression);
+            job.crc = NVRam_crc((const uint8_t*)data, size, 0);
+        }
+    };
+
+    vector<thread> pool;
+    for(unsigned int i = 1; i < threads && i < jobs.size(); i++)
+    {
+        pool.push_back(thread(worker));
+    }
+
+    worker();
+
+    for(size_t i = 0; i < pool.size(); i++)
+    {
+        pool[i].join();
+    }
+}
+
 #define MAX_SIZE      (1024u * 256u) /* 256KB - max NVRAM */
 int main(int argc, char const *argv[])
 {
     uint32_t byteOffset = 0;
     int numSections = 0;
+    vector<section_job_t> jobs;
     union {
         uint8_t     bytes[MAX_SIZE];
         uint32_t    words[MAX_SIZE/4];
@@ -142,6 +191,17 @@ int main(int argc, char const *argv[])
             .help("Output ape binary")
             .metavar("FILE");
 
+    parser.add_option("-j", "--jobs")
+            .dest("jobs")
+            .help("Number of sections to compress in parallel, defaults to the number of CPUs.")
+            .metavar("N");
+
+    parser.add_option("--best")
+            .dest("best")
+            .action("store_true")
+            .set_default("0")
+            .help("Compress sections as small as possible, at the cost of build time.");
+
     optparse::Values options = parser.parse_args(argc, argv);
     vector<string> args = parser.args();
 
@@ -238,40 +298,73 @@ int main(int argc, char const *argv[])
                           << psec->get_address()
                           << std::endl;
 
-                APESection_t *section = &ape.header.section[numSections++];
-                section->flags = 0;
-                section->offset = byteOffset;
-
-                const char* data = psec->get_data();
-                if(data)
-                {
-                    uint32_t compressedSize = compress((uint8_t*)&ape.bytes[byteOffset], psec->get_size() * 2, // Output, compressed
-                                                                              (const uint8_t*)data, psec->get_size());    // input, uncompressed
-                    // ROund up to nearest word.
-                    compressedSize = ((compressedSize + 3) / 4) * 4;
-
-                    section->compressedSize = compressedSize;
-                    byteOffset += section->compressedSize;
-                    // memcpy(&ape.bytes[byteOffset], compressed, section->compressedSize);
-                    // byteOffset += section->compressedSize;
-                    section->crc = NVRam_crc((const uint8_t*)data, psec->get_size(), 0);
-                    section->flags |= APE_SECTION_FLAG_CHECKSUM_IS_CRC32 | APE_SECTION_FLAG_COMPRESSED;
-                }
-                else
-                {
-                    section->compressedSize = 0;
-                    section->crc = 0;
-                    section->flags |= APE_SECTION_FLAG_ZERO_ON_FAST_BOOT;
-                }
-                section->decompressedSize = psec->get_size();
-                section->loadAddr = psec->get_address();
-
-                if(psec->get_flags() & SHF_EXECINSTR)
-                {
-                    section->flags |= APE_SECTION_FLAG_CODE;
-                }
+                section_job_t job = { psec };
+                jobs.push_back(job);
+                numSections++;
+            }
+
+        }
+    }
+
+    compress_options_t compression = { COMPRESS_TREE };
+    if(options.get("best"))
+    {
+        compression.parse = COMPRESS_OPTIMAL;
+    }
+
+    unsigned int threads = thread::hardware_concurrency();
+    if(options.is_set("jobs"))
+    {
+        threads = atoi(options["jobs"].c_str());
+    }
+    compress_sections(jobs, &compression, threads);
+
+    // Lay the sections out in ELF order, independent of completion order.
+    for(size_t i = 0; i < jobs.size(); i++)
+    {
+        const section_job_t& job = jobs[i];
+        section* psec = job.psec;
+
+        APESection_t *section = &ape.header.section[i];
+        section->flags = 0;
+        section->offset = byteOffset;
+
+        if(psec->get_data())
+        {
+            if(job.compressedSize < 0)
+            {
+                cerr << "Unable to compress section " << psec->get_name() << "." << endl;
+                exit(-1);
+            }
+
+            // ROund up to nearest word.
+            uint32_t compressedSize = ((job.compressedSize + 3) / 4) * 4;
+            if(byteOffset + compressedSize > MAX_SIZE)
+            {
+                cerr << "Section " << psec->get_name() << " does not fit in the image." << endl;
+                exit(-1);
             }
 
+            memcpy(&ape.bytes[byteOffset], job.compressed.data(), job.compressedSize);
+            memset(&ape.bytes[byteOffset + job.compressedSize], 0, compressedSize - job.compressedSize);
+
+            section->compressedSize = compressedSize;
+            byteOffset += section->compressedSize;
+            section->crc = job.crc;
+            section->flags |= APE_SECTION_FLAG_CHECKSUM_IS_CRC32 | APE_SECTION_FLAG_COMPRESSED;
+        }
+        else
+        {
+            section->compressedSize = 0;
+            section->crc = 0;
+            section->flags |= APE_SECTION_FLAG_ZERO_ON_FAST_BOOT;
+        }
+        section->decompressedSize = psec->get_size();
+        section->loadAddr = psec->get_address();
+
+        if(psec->get_flags() & SHF_EXECINSTR)
+        {
+            section->flags |= APE_SECTION_FLAG_CODE;
         }
     }
 